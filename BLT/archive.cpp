@@ -0,0 +1,204 @@
+#include "archive.h"
+#include "binio.h"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const char ARCHIVE_MAGIC[4] = {'B', 'L', 'T', 'A'};
+static const size_t HEADER_BYTES = sizeof(ARCHIVE_MAGIC) + 4 + 4 + 4;
+
+AssetArchive::AssetArchive() {
+    data = nullptr;
+    size = 0;
+#ifdef _WIN32
+    fileHandle = nullptr;
+    mappingHandle = nullptr;
+#endif
+}
+
+AssetArchive::~AssetArchive() {
+    close();
+}
+
+bool AssetArchive::open(const std::string& path) {
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        std::cerr << "Failed to map asset archive " << path << std::endl;
+        if (mapping) CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    fileHandle = file;
+    mappingHandle = mapping;
+    data = (const unsigned char*)view;
+    size = (size_t)fileSize.QuadPart;
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+    void* view = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // Vùng đã map vẫn giữ được sau khi đóng file
+    ::close(fd);
+    if (view == MAP_FAILED) {
+        std::cerr << "Failed to map asset archive " << path << std::endl;
+        return false;
+    }
+    data = (const unsigned char*)view;
+    size = (size_t)info.st_size;
+#endif
+
+    if (!readIndex(path)) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void AssetArchive::close() {
+    if (data) {
+#ifdef _WIN32
+        UnmapViewOfFile(data);
+        CloseHandle((HANDLE)mappingHandle);
+        CloseHandle((HANDLE)fileHandle);
+        mappingHandle = nullptr;
+        fileHandle = nullptr;
+#else
+        munmap((void*)data, size);
+#endif
+    }
+    data = nullptr;
+    size = 0;
+    index.clear();
+}
+
+bool AssetArchive::readIndex(const std::string& path) {
+    if (size < HEADER_BYTES + 4 || std::memcmp(data, ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC)) != 0) {
+        std::cerr << "Not an asset archive: " << path << std::endl;
+        return false;
+    }
+
+    // Chỉ sao chép phần đầu và mục lục (vài trăm byte), dữ liệu file vẫn nằm yên trong vùng map
+    std::istringstream header(std::string((const char*)data + sizeof(ARCHIVE_MAGIC), HEADER_BYTES - sizeof(ARCHIVE_MAGIC)));
+    uint32_t version = 0;
+    uint32_t count = 0;
+    uint32_t indexBytes = 0;
+    readU32(header, version);
+    readU32(header, count);
+    readU32(header, indexBytes);
+    if (version != FORMAT_VERSION || indexBytes > size - HEADER_BYTES - 4) {
+        std::cerr << "Unsupported asset archive " << path << std::endl;
+        return false;
+    }
+
+    std::string indexData((const char*)data + HEADER_BYTES, indexBytes);
+    std::istringstream storedTail(std::string((const char*)data + HEADER_BYTES + indexBytes, 4));
+    uint32_t storedChecksum = 0;
+    if (!readU32(storedTail, storedChecksum) || storedChecksum != checksum(indexData)) {
+        std::cerr << "Asset archive " << path << " is corrupt" << std::endl;
+        return false;
+    }
+
+    std::istringstream in(indexData);
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t nameLength = 0;
+        std::string name;
+        Entry entry;
+        bool ok = readVarint(in, nameLength) && nameLength <= indexBytes;
+        if (ok) {
+            name.resize(nameLength);
+            ok = in.read(&name[0], nameLength) && readU64(in, entry.offset) && readU64(in, entry.size)
+                && entry.offset <= size && entry.size <= size - entry.offset;
+        }
+        if (!ok) {
+            std::cerr << "Asset archive " << path << " has a bad entry" << std::endl;
+            return false;
+        }
+        index[name] = entry;
+    }
+    return true;
+}
+
+bool AssetArchive::find(const std::string& name, const void*& bytes, size_t& length) const {
+    auto it = index.find(name);
+    if (it == index.end()) return false;
+
+    bytes = data + it->second.offset;
+    length = (size_t)it->second.size;
+    return true;
+}
+
+bool AssetArchive::write(const std::string& path, const std::vector<std::string>& names,
+                         const std::vector<std::string>& contents) {
+    if (names.size() != contents.size()) return false;
+
+    // Mục lục chứa offset tuyệt đối nên phải biết trước độ dài của chính nó
+    size_t indexBytes = 0;
+    for (const std::string& name : names) {
+        std::ostringstream varint;
+        writeVarint(varint, (uint32_t)name.size());
+        indexBytes += varint.str().size() + name.size() + 8 + 8;
+    }
+
+    uint64_t offset = HEADER_BYTES + indexBytes + 4;
+    std::vector<uint64_t> offsets;
+    std::ostringstream indexData;
+    for (size_t i = 0; i < names.size(); i++) {
+        offset = (offset + DATA_ALIGNMENT - 1) / DATA_ALIGNMENT * DATA_ALIGNMENT;
+        offsets.push_back(offset);
+        writeVarint(indexData, (uint32_t)names[i].size());
+        indexData.write(names[i].data(), names[i].size());
+        writeU64(indexData, offset);
+        writeU64(indexData, contents[i].size());
+        offset += contents[i].size();
+    }
+
+    std::ofstream outFile(path, std::ios::binary | std::ios::trunc);
+    if (!outFile.is_open()) {
+        std::cerr << "Failed to write asset archive " << path << std::endl;
+        return false;
+    }
+
+    outFile.write(ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC));
+    writeU32(outFile, FORMAT_VERSION);
+    writeU32(outFile, (uint32_t)names.size());
+    writeU32(outFile, (uint32_t)indexBytes);
+    outFile.write(indexData.str().data(), indexData.str().size());
+    writeU32(outFile, checksum(indexData.str()));
+
+    uint64_t position = HEADER_BYTES + indexBytes + 4;
+    for (size_t i = 0; i < contents.size(); i++) {
+        for (; position < offsets[i]; position++) outFile.put('\0');
+        outFile.write(contents[i].data(), contents[i].size());
+        position += contents[i].size();
+    }
+
+    return (bool)outFile;
+}
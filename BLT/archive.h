@@ -0,0 +1,54 @@
+#ifndef ARCHIVE_H_INCLUDED
+#define ARCHIVE_H_INCLUDED
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Gói toàn bộ ảnh, âm thanh, font vào một file có mục lục, tạo bằng tools/pack_assets.cpp.
+//   "BLTA" | version | số file | mục lục (tên, offset, độ dài) | checksum mục lục | dữ liệu
+// Lúc chạy file được mmap, find() trả về con trỏ thẳng vào vùng nhớ đó nên không phải sao chép;
+// hệ điều hành chỉ đọc từ đĩa những trang thật sự được dùng.
+class AssetArchive {
+private:
+    static constexpr uint32_t FORMAT_VERSION = 1;
+    // Dữ liệu mỗi file bắt đầu ở biên này
+    static constexpr uint64_t DATA_ALIGNMENT = 16;
+
+    struct Entry {
+        uint64_t offset;
+        uint64_t size;
+    };
+
+    const unsigned char* data;
+    size_t size;
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#endif
+    std::unordered_map<std::string, Entry> index;
+
+    bool readIndex(const std::string& path);
+
+public:
+    AssetArchive();
+    ~AssetArchive();
+
+    AssetArchive(const AssetArchive&) = delete;
+    AssetArchive& operator=(const AssetArchive&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return data != nullptr; }
+
+    // Con trỏ chỉ còn hợp lệ tới khi close()
+    bool find(const std::string& name, const void*& bytes, size_t& length) const;
+    size_t getFileCount() const { return index.size(); }
+
+    // Dùng cho công cụ đóng gói; names[i] là tên tra cứu của contents[i]
+    static bool write(const std::string& path, const std::vector<std::string>& names,
+                      const std::vector<std::string>& contents);
+};
+
+#endif // ARCHIVE_H_INCLUDED
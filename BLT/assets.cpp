@@ -0,0 +1,30 @@
+#include "assets.h"
+
+bool AssetSource::openArchive(const std::string& path) {
+    if (archive.open(path)) {
+        SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO, "Using asset archive %s", path.c_str());
+        return true;
+    }
+
+    char* basePath = SDL_GetBasePath();
+    if (basePath) {
+        std::string besideExecutable = std::string(basePath) + path;
+        SDL_free(basePath);
+        if (archive.open(besideExecutable)) {
+            SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO, "Using asset archive %s", besideExecutable.c_str());
+            return true;
+        }
+    }
+
+    SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO, "No asset archive %s, loading loose files", path.c_str());
+    return false;
+}
+
+SDL_RWops* AssetSource::open(const std::string& name) const {
+    const void* bytes = nullptr;
+    size_t length = 0;
+    if (archive.find(name, bytes, length)) {
+        return SDL_RWFromConstMem(bytes, (int)length);
+    }
+    return SDL_RWFromFile(name.c_str(), "rb");
+}
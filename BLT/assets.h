@@ -0,0 +1,24 @@
+#ifndef ASSETS_H_INCLUDED
+#define ASSETS_H_INCLUDED
+#include <SDL.h>
+#include <string>
+#include "archive.h"
+
+// Nơi lấy ảnh, âm thanh, font: ưu tiên gói đã mmap (không sao chép, không phụ thuộc thư mục làm việc),
+// file nào không có trong gói thì đọc file rời theo đường dẫn tương đối như trước.
+class AssetSource {
+private:
+    AssetArchive archive;
+
+public:
+    // Tìm gói ở path, rồi ở thư mục chứa file chạy; không thấy thì chỉ dùng file rời
+    bool openArchive(const std::string& path);
+    bool hasArchive() const { return archive.isOpen(); }
+
+    // name là đường dẫn tương đối dùng '/', ví dụ "images/menu.png". Người gọi giải phóng
+    // SDL_RWops (thường bằng tham số freesrc của các hàm *_RW). Dữ liệu lấy từ gói chỉ hợp lệ
+    // khi AssetSource còn sống, nên font mở từ đây phải đóng trước khi huỷ AssetSource.
+    SDL_RWops* open(const std::string& name) const;
+};
+
+#endif // ASSETS_H_INCLUDED
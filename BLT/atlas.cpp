@@ -0,0 +1,77 @@
+#include "atlas.h"
+#include <iostream>
+#include <algorithm>
+
+TextureAtlas::TextureAtlas() {
+    texture = nullptr;
+    whiteRegion = {0, 0, 0, 0};
+    penX = 0;
+    penY = 0;
+    rowHeight = 0;
+}
+
+TextureAtlas::~TextureAtlas() {
+    if (texture) SDL_DestroyTexture(texture);
+}
+
+bool TextureAtlas::init(SDL_Renderer* renderer, int count) {
+    regions.assign(count, {0, 0, 0, 0});
+
+    // Xoá trong suốt cả texture để khe 1px giữa các ảnh không lem màu rác khi lọc tuyến tính
+    SDL_Surface* pixels = SDL_CreateRGBSurfaceWithFormat(0, ATLAS_WIDTH, ATLAS_HEIGHT, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!pixels) {
+        std::cerr << "Unable to create sprite atlas surface! SDL Error: " << SDL_GetError() << std::endl;
+        return false;
+    }
+    SDL_FillRect(pixels, NULL, SDL_MapRGBA(pixels->format, 0, 0, 0, 0));
+
+    // Ô trắng để vẽ hình chữ nhật tô màu cùng lượt với sprite; chừa viền 1px cùng màu cho lọc tuyến tính
+    SDL_Rect whiteFill;
+    place(4, 4, whiteFill);
+    whiteRegion = {whiteFill.x + 1, whiteFill.y + 1, 2, 2};
+    SDL_FillRect(pixels, &whiteFill, SDL_MapRGBA(pixels->format, 255, 255, 255, 255));
+
+    texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, ATLAS_WIDTH, ATLAS_HEIGHT);
+    if (!texture) {
+        std::cerr << "Unable to create sprite atlas texture! SDL Error: " << SDL_GetError() << std::endl;
+        SDL_FreeSurface(pixels);
+        return false;
+    }
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    SDL_UpdateTexture(texture, NULL, pixels->pixels, pixels->pitch);
+    SDL_FreeSurface(pixels);
+    return true;
+}
+
+// Xếp theo hàng theo thứ tự ảnh tới, chừa 1px giữa các ảnh để không bị lem khi lọc tuyến tính
+bool TextureAtlas::place(int width, int height, SDL_Rect& out) {
+    if (width > ATLAS_WIDTH) return false;
+    if (penX + width > ATLAS_WIDTH) {
+        penX = 0;
+        penY += rowHeight + 1;
+        rowHeight = 0;
+    }
+    if (penY + height > ATLAS_HEIGHT) return false;
+
+    out = {penX, penY, width, height};
+    penX += width + 1;
+    rowHeight = std::max(rowHeight, height);
+    return true;
+}
+
+bool TextureAtlas::add(int index, SDL_Surface* surface) {
+    if (!texture || !surface || index < 0 || index >= (int)regions.size()) return false;
+
+    SDL_Rect dest;
+    if (!place(surface->w, surface->h, dest)) {
+        std::cerr << "Sprite " << index << " does not fit in the atlas" << std::endl;
+        return false;
+    }
+
+    if (SDL_UpdateTexture(texture, &dest, surface->pixels, surface->pitch) != 0) {
+        std::cerr << "Unable to upload sprite " << index << "! SDL Error: " << SDL_GetError() << std::endl;
+        return false;
+    }
+    regions[index] = dest;
+    return true;
+}
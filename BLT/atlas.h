@@ -0,0 +1,41 @@
+#ifndef ATLAS_H_INCLUDED
+#define ATLAS_H_INCLUDED
+#include <SDL.h>
+#include <vector>
+
+// Ghép tất cả ảnh sprite vào một texture duy nhất. Ảnh được thêm dần khi giải mã xong,
+// mỗi ảnh chỉ cập nhật đúng vùng của nó lên texture.
+// Texture được tạo một lần với kích thước cố định và không bao giờ tạo lại: SpriteBatch giữ con trỏ
+// texture cùng kích thước của nó, nên đổi texture giữa chừng sẽ làm hỏng toạ độ UV.
+class TextureAtlas {
+private:
+    static const int ATLAS_WIDTH = 1024;
+    // Ảnh tới theo thứ tự bất kỳ nên phải đủ cho cách xếp tệ nhất, tức mỗi ảnh một hàng:
+    // tổng chiều cao các sprite hiện có cộng khe 1px là khoảng 1800
+    static const int ATLAS_HEIGHT = 2048;
+
+    SDL_Texture* texture;
+    std::vector<SDL_Rect> regions;
+    SDL_Rect whiteRegion;
+
+    int penX;
+    int penY;
+    int rowHeight;
+
+    bool place(int width, int height, SDL_Rect& out);
+
+public:
+    TextureAtlas();
+    ~TextureAtlas();
+
+    bool init(SDL_Renderer* renderer, int count);
+    // surface phải ở định dạng SDL_PIXELFORMAT_RGBA32; người gọi vẫn giữ quyền giải phóng nó
+    bool add(int index, SDL_Surface* surface);
+
+    SDL_Texture* getTexture() const { return texture; }
+    bool hasRegion(int index) const { return texture && index >= 0 && index < (int)regions.size() && regions[index].w > 0; }
+    const SDL_Rect& getRegion(int index) const { return regions[index]; }
+    const SDL_Rect& getWhiteRegion() const { return whiteRegion; }
+};
+
+#endif // ATLAS_H_INCLUDED
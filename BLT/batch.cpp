@@ -0,0 +1,72 @@
+#include "batch.h"
+
+SpriteBatch::SpriteBatch() {}
+
+SpriteBatch::~SpriteBatch() {}
+
+SpriteBatch::Batch& SpriteBatch::findBatch(SDL_Texture* texture) {
+    for (int index : order) {
+        if (batches[index].texture == texture) return batches[index];
+    }
+
+    for (int i = 0; i < (int)batches.size(); i++) {
+        if (batches[i].texture == texture) {
+            order.push_back(i);
+            return batches[i];
+        }
+    }
+
+    int width = 1;
+    int height = 1;
+    SDL_QueryTexture(texture, NULL, NULL, &width, &height);
+
+    Batch batch;
+    batch.texture = texture;
+    batch.invWidth = 1.0f / width;
+    batch.invHeight = 1.0f / height;
+    batches.push_back(batch);
+    order.push_back((int)batches.size() - 1);
+    return batches.back();
+}
+
+void SpriteBatch::draw(SDL_Texture* texture, const SDL_Rect& src, const SDL_FRect& dest, SDL_Color color) {
+    if (!texture) return;
+
+    Batch& batch = findBatch(texture);
+
+    float u0 = src.x * batch.invWidth;
+    float v0 = src.y * batch.invHeight;
+    float u1 = (src.x + src.w) * batch.invWidth;
+    float v1 = (src.y + src.h) * batch.invHeight;
+
+    float left = dest.x;
+    float top = dest.y;
+    float right = dest.x + dest.w;
+    float bottom = dest.y + dest.h;
+
+    int base = (int)batch.vertices.size();
+    batch.vertices.push_back({{left, top}, color, {u0, v0}});
+    batch.vertices.push_back({{right, top}, color, {u1, v0}});
+    batch.vertices.push_back({{right, bottom}, color, {u1, v1}});
+    batch.vertices.push_back({{left, bottom}, color, {u0, v1}});
+
+    batch.indices.push_back(base);
+    batch.indices.push_back(base + 1);
+    batch.indices.push_back(base + 2);
+    batch.indices.push_back(base);
+    batch.indices.push_back(base + 2);
+    batch.indices.push_back(base + 3);
+}
+
+void SpriteBatch::flush(SDL_Renderer* renderer) {
+    for (int index : order) {
+        Batch& batch = batches[index];
+        if (batch.indices.empty()) continue;
+
+        SDL_RenderGeometry(renderer, batch.texture, batch.vertices.data(), (int)batch.vertices.size(),
+                           batch.indices.data(), (int)batch.indices.size());
+        batch.vertices.clear();
+        batch.indices.clear();
+    }
+    order.clear();
+}
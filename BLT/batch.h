@@ -0,0 +1,31 @@
+#ifndef BATCH_H_INCLUDED
+#define BATCH_H_INCLUDED
+#include <SDL.h>
+#include <vector>
+
+// Gom các quad theo texture rồi gửi mỗi texture bằng đúng một lần SDL_RenderGeometry.
+// Thứ tự vẽ giữa các texture theo thứ tự texture đó được dùng lần đầu trong frame.
+class SpriteBatch {
+private:
+    struct Batch {
+        SDL_Texture* texture;
+        float invWidth;
+        float invHeight;
+        std::vector<SDL_Vertex> vertices;
+        std::vector<int> indices;
+    };
+
+    std::vector<Batch> batches;
+    std::vector<int> order;
+
+    Batch& findBatch(SDL_Texture* texture);
+
+public:
+    SpriteBatch();
+    ~SpriteBatch();
+
+    void draw(SDL_Texture* texture, const SDL_Rect& src, const SDL_FRect& dest, SDL_Color color = {255, 255, 255, 255});
+    void flush(SDL_Renderer* renderer);
+};
+
+#endif // BATCH_H_INCLUDED
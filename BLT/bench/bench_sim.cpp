@@ -0,0 +1,182 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "chunk.h"
+#include "def.h"
+#include "env.h"
+#include "platform.h"
+#include "player.h"
+#include "world.h"
+
+// Mọi benchmark đều dùng seed cố định để kết quả giữa các lần chạy so sánh được.
+static const uint64_t BENCH_SEED = 12345;
+
+// Chiều cao "màn hình" đủ để initialize(count) giữ khoảng cách platform như trong game
+static int screenHeightFor(int platformCount) {
+    return std::max(SCREEN_HEIGHT, platformCount * (SCREEN_HEIGHT / 15));
+}
+
+static void BM_PlayerUpdate(benchmark::State& state) {
+    float fallVelocity = (float)state.range(0);
+    int platformCount = (int)state.range(1);
+    int screenHeight = screenHeightFor(platformCount);
+
+    PlatformManager platformManager(SCREEN_WIDTH, screenHeight, BENCH_SEED);
+    platformManager.initialize(platformCount);
+    Player player(SCREEN_WIDTH / 2, screenHeight / 2, 80);
+
+    for (auto _ : state) {
+        player.setPosition(SCREEN_WIDTH / 2, screenHeight / 2);
+        player.jump();
+        player.setVelocityY(fallVelocity);
+        player.update(platformManager);
+        benchmark::DoNotOptimize(player.getY());
+    }
+}
+// Chỉ các vận tốc rơi: đang bay lên thì update() trả về trước khi xét va chạm
+BENCHMARK(BM_PlayerUpdate)
+    ->ArgNames({"velocity", "platforms"})
+    ->ArgsProduct({{1, 8, 32, 128}, {15, 100, 1000}});
+
+// Mốc so sánh: người chơi đang bay lên, update() chỉ cộng trọng lực và dời vị trí
+static void BM_PlayerUpdateRisingBaseline(benchmark::State& state) {
+    PlatformManager platformManager(SCREEN_WIDTH, SCREEN_HEIGHT, BENCH_SEED);
+    platformManager.initialize(15);
+    Player player(SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2, 80);
+
+    for (auto _ : state) {
+        player.setPosition(SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2);
+        player.jump();
+        player.setVelocityY(-9);
+        player.update(platformManager);
+        benchmark::DoNotOptimize(player.getY());
+    }
+    state.SetLabel("baseline, no collision test");
+}
+BENCHMARK(BM_PlayerUpdateRisingBaseline);
+
+static void BM_PlatformManagerUpdate(benchmark::State& state) {
+    int platformCount = (int)state.range(0);
+    int screenHeight = screenHeightFor(platformCount);
+
+    PlatformManager platformManager(SCREEN_WIDTH, screenHeight, BENCH_SEED);
+    platformManager.initialize(platformCount);
+
+    for (auto _ : state) {
+        platformManager.update();
+        benchmark::ClobberMemory();
+    }
+    // update() không chạm tới lane NORMAL, nên chỉ đếm các platform thực sự được xử lý
+    size_t updated = platformManager.getLane(PlatformType::MOVING).size()
+        + platformManager.getLane(PlatformType::BREAKABLE).size();
+    state.SetItemsProcessed(state.iterations() * updated);
+}
+BENCHMARK(BM_PlatformManagerUpdate)->ArgName("platforms")->Arg(15)->Arg(100)->Arg(1000)->Arg(10000);
+
+static void BM_RemoveBottomPlatforms(benchmark::State& state) {
+    int platformCount = (int)state.range(0);
+    int screenHeight = screenHeightFor(platformCount);
+
+    PlatformManager platformManager(SCREEN_WIDTH, screenHeight, BENCH_SEED);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        platformManager.initialize(platformCount);
+        state.ResumeTiming();
+
+        // Camera lên nửa màn hình: khoảng một nửa số platform bị loại
+        platformManager.removeBottomPlatforms(-screenHeight / 2.0);
+        benchmark::DoNotOptimize(platformManager.getPlatformCount());
+    }
+}
+BENCHMARK(BM_RemoveBottomPlatforms)->ArgName("platforms")->Arg(15)->Arg(100)->Arg(1000);
+
+static void BM_GenerateChunk(benchmark::State& state) {
+    int difficulty = (int)state.range(0);
+    int index = (difficulty * 1000 + CHUNK_HEIGHT - 1) / CHUNK_HEIGHT;
+
+    LevelChunk chunk;
+    for (auto _ : state) {
+        generateChunk(BENCH_SEED, index, SCREEN_WIDTH, PLATFORM_WIDTH, chunk);
+        benchmark::DoNotOptimize(chunk);
+    }
+}
+BENCHMARK(BM_GenerateChunk)->ArgName("difficulty")->DenseRange(0, 10, 2);
+
+// Truy vấn một màn hình ở độ cao bất kỳ; thời gian không được tăng theo độ cao
+static void BM_QueryLevel(benchmark::State& state) {
+    double height = (double)state.range(0);
+    uint64_t levelSeed = levelSeedFor(BENCH_SEED, 0);
+
+    std::vector<LevelPlatform> platforms;
+    for (auto _ : state) {
+        queryLevel(levelSeed, -height - SCREEN_HEIGHT, -height, SCREEN_WIDTH, PLATFORM_WIDTH, platforms);
+        benchmark::DoNotOptimize(platforms.data());
+    }
+}
+BENCHMARK(BM_QueryLevel)->ArgName("height")->Arg(1000)->Arg(50000)->Arg(1000000);
+
+static void BM_IsOverlapping(benchmark::State& state) {
+    int platformCount = (int)state.range(0);
+    int screenHeight = screenHeightFor(platformCount);
+
+    PlatformManager platformManager(SCREEN_WIDTH, screenHeight, BENCH_SEED);
+    platformManager.initialize(platformCount);
+
+    int y = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(platformManager.isOverlapping(SCREEN_WIDTH / 2, y));
+        y = (y + 37) % screenHeight;
+    }
+}
+BENCHMARK(BM_IsOverlapping)->ArgName("platforms")->Arg(15)->Arg(100)->Arg(1000);
+
+static void BM_WorldTick(benchmark::State& state) {
+    World world(SCREEN_WIDTH, SCREEN_HEIGHT, BENCH_SEED);
+    InputState input = {false, false};
+    int tick = 0;
+
+    for (auto _ : state) {
+        input.right = (tick / 60) % 2 == 0;
+        input.left = !input.right;
+        world.tick(input);
+        if (world.isGameOver()) world.restart();
+        tick++;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_WorldTick);
+
+static void BM_WorldSnapshotRestore(benchmark::State& state) {
+    World world(SCREEN_WIDTH, SCREEN_HEIGHT, BENCH_SEED);
+    for (int i = 0; i < 600; i++) world.tick({false, (i / 60) % 2 == 0});
+
+    WorldSnapshot snapshot;
+    for (auto _ : state) {
+        world.snapshot(snapshot);
+        benchmark::DoNotOptimize(snapshot);
+        world.restore(snapshot);
+    }
+    state.SetBytesProcessed(state.iterations() * (int64_t)sizeof(WorldSnapshot));
+}
+BENCHMARK(BM_WorldSnapshotRestore);
+
+static void BM_BatchEnvStep(benchmark::State& state) {
+    int envCount = (int)state.range(0);
+    int threadCount = (int)state.range(1);
+    BatchEnv env(envCount, BENCH_SEED, threadCount);
+
+    std::vector<int> actions(envCount);
+    int step = 0;
+    for (auto _ : state) {
+        for (int i = 0; i < envCount; i++) {
+            actions[i] = (step / 30 + i) % 3;
+        }
+        env.step(actions.data());
+        step++;
+    }
+    state.SetItemsProcessed(state.iterations() * envCount);
+}
+BENCHMARK(BM_BatchEnvStep)->ArgNames({"envs", "threads"})
+    ->Args({256, 1})->Args({4096, 1})->Args({4096, 0})->UseRealTime();
+
+BENCHMARK_MAIN();
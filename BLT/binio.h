@@ -0,0 +1,98 @@
+#ifndef BINIO_H_INCLUDED
+#define BINIO_H_INCLUDED
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <string>
+
+// Đọc/ghi số dạng nhị phân cho file replay, bảng điểm và gói tài nguyên.
+// Luôn ghi little-endian để file đọc được trên mọi máy
+inline void writeU32(std::ostream& out, uint32_t value) {
+    for (int i = 0; i < 4; i++) out.put((char)((value >> (8 * i)) & 0xFF));
+}
+
+inline void writeU64(std::ostream& out, uint64_t value) {
+    for (int i = 0; i < 8; i++) out.put((char)((value >> (8 * i)) & 0xFF));
+}
+
+inline void writeFloat(std::ostream& out, float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    writeU32(out, bits);
+}
+
+// Độ dài đoạn ghi dạng varint (7 bit mỗi byte), đoạn ngắn chỉ tốn 1 byte
+inline void writeVarint(std::ostream& out, uint32_t value) {
+    while (value >= 0x80) {
+        out.put((char)((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.put((char)value);
+}
+
+inline bool readU32(std::istream& in, uint32_t& value) {
+    unsigned char bytes[4];
+    if (!in.read((char*)bytes, 4)) return false;
+    value = 0;
+    for (int i = 0; i < 4; i++) value |= (uint32_t)bytes[i] << (8 * i);
+    return true;
+}
+
+inline bool readU64(std::istream& in, uint64_t& value) {
+    unsigned char bytes[8];
+    if (!in.read((char*)bytes, 8)) return false;
+    value = 0;
+    for (int i = 0; i < 8; i++) value |= (uint64_t)bytes[i] << (8 * i);
+    return true;
+}
+
+inline bool readFloat(std::istream& in, float& value) {
+    uint32_t bits;
+    if (!readU32(in, bits)) return false;
+    std::memcpy(&value, &bits, sizeof(value));
+    return true;
+}
+
+inline bool readVarint(std::istream& in, uint32_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        int byte = in.get();
+        if (byte == EOF) return false;
+        value |= (uint32_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+inline void writeDouble(std::ostream& out, double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    writeU64(out, bits);
+}
+
+inline bool readDouble(std::istream& in, double& value) {
+    uint64_t bits;
+    if (!readU64(in, bits)) return false;
+    std::memcpy(&value, &bits, sizeof(value));
+    return true;
+}
+
+inline bool readI32(std::istream& in, int32_t& value) {
+    uint32_t bits;
+    if (!readU32(in, bits)) return false;
+    value = (int32_t)bits;
+    return true;
+}
+
+// FNV-1a, đủ để phát hiện dữ liệu bị cắt dở hay hỏng
+inline uint32_t checksum(const std::string& bytes) {
+    uint32_t hash = 2166136261u;
+    for (unsigned char byte : bytes) {
+        hash = (hash ^ byte) * 16777619u;
+    }
+    return hash;
+}
+
+#endif // BINIO_H_INCLUDED
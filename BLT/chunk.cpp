@@ -0,0 +1,80 @@
+#include "chunk.h"
+#include "def.h"
+#include "platform.h"
+#include "rng.h"
+#include <algorithm>
+#include <cmath>
+
+int difficultyAtHeight(double height) {
+    return height > 0.0 ? (int)(height / 1000.0) : 0;
+}
+
+int chunkDifficulty(int index) {
+    return difficultyAtHeight((double)index * CHUNK_HEIGHT);
+}
+
+int chunkIndexAt(double y) {
+    if (y >= 0.0) return 0;
+    return std::max(0, (int)std::ceil(-y / CHUNK_HEIGHT) - 1);
+}
+
+uint64_t levelSeedFor(uint64_t seed, int life) {
+    // Luồng PCG32 riêng cho việc cấp seed, tách khỏi luồng của từng chunk
+    Rng rng(seed, 0x4C4556454Cull + (uint64_t)life);
+    return ((uint64_t)rng.next() << 32) | rng.next();
+}
+
+void generateChunk(uint64_t seed, int index, int screenWidth, int platformWidth, LevelChunk& out) {
+    // Mỗi chunk dùng một luồng PCG32 riêng, không phụ thuộc các chunk khác
+    Rng rng(seed, (uint64_t)index);
+
+    int difficulty = chunkDifficulty(index);
+    double spacing = chunkRowSpacing(difficulty);
+    int rows = (int)std::lround(CHUNK_HEIGHT / spacing);
+    int platformsPerLevel = std::max(2, 5 - (difficulty / 2));
+
+    int movingChance = std::min(15 + (difficulty * 3), 30);
+    int breakableChance = std::min(10 + (difficulty * 10), 40);
+
+    out.seed = seed;
+    out.index = index;
+    out.difficulty = difficulty;
+    out.count = rows;
+
+    // Hàng cuối nằm đúng mép trên của chunk, nên khoảng cách giữa hai chunk cũng bằng spacing
+    double bottom = -(double)index * CHUNK_HEIGHT;
+    for (int row = 0; row < rows; row++) {
+        out.y[row] = bottom - (row + 1) * spacing;
+        out.x[row] = (float)rng.range(0, screenWidth - platformWidth);
+
+        // Cứ platformsPerLevel hàng lại có một platform thường, giống mỗi lượt sinh trước đây
+        PlatformType platformType = PlatformType::NORMAL;
+        if (row % platformsPerLevel != 0) {
+            int randVal = (int)rng.bounded(100);
+            if (randVal < breakableChance) {
+                platformType = PlatformType::BREAKABLE;
+            } else if (randVal < breakableChance + movingChance) {
+                platformType = PlatformType::MOVING;
+            }
+        }
+        out.type[row] = (uint8_t)platformType;
+    }
+}
+
+void queryLevel(uint64_t levelSeed, double topY, double bottomY, int screenWidth, int platformWidth,
+                std::vector<LevelPlatform>& out) {
+    out.clear();
+    if (topY > bottomY || topY >= 0.0) return;
+
+    LevelChunk chunk;
+    int first = chunkIndexAt(bottomY);
+    int last = chunkIndexAt(topY);
+    for (int index = first; index <= last; index++) {
+        generateChunk(levelSeed, index, screenWidth, platformWidth, chunk);
+        for (int i = 0; i < chunk.count; i++) {
+            if (chunk.y[i] >= topY && chunk.y[i] <= bottomY) {
+                out.push_back({chunk.x[i], chunk.y[i], chunk.type[i], chunk.difficulty});
+            }
+        }
+    }
+}
@@ -0,0 +1,52 @@
+#ifndef CHUNK_H_INCLUDED
+#define CHUNK_H_INCLUDED
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "def.h"
+
+// Màn chơi phía trên màn hình đầu tiên được chia thành các dải cao CHUNK_HEIGHT pixel.
+// Chunk thứ i phủ toạ độ thế giới y trong [-(i + 1) * CHUNK_HEIGHT, -i * CHUNK_HEIGHT).
+// Nội dung mỗi chunk chỉ phụ thuộc vào (seed, i), nên sinh ở đâu, lúc nào cũng cho cùng kết quả.
+const int CHUNK_HEIGHT = 480;
+const int CHUNK_MAX_PLATFORMS = 16;
+
+struct LevelChunk {
+    uint64_t seed;
+    int32_t index;
+    int32_t difficulty;
+    int32_t count;
+    float x[CHUNK_MAX_PLATFORMS];
+    double y[CHUNK_MAX_PLATFORMS];
+    uint8_t type[CHUNK_MAX_PLATFORMS];
+};
+
+struct LevelPlatform {
+    float x;
+    double y;
+    uint8_t type;
+    int32_t difficulty;
+};
+
+// Độ khó chỉ phụ thuộc độ cao (pixel tính từ đáy màn hình đầu), cứ 1000 pixel tăng một bậc
+int difficultyAtHeight(double height);
+// Độ khó của chunk lấy theo độ cao mép dưới của nó
+int chunkDifficulty(int index);
+// Chunk chứa toạ độ thế giới y (y < 0); hàng trên cùng nằm đúng mép trên thuộc về chunk dưới
+int chunkIndexAt(double y);
+// Seed màn chơi của lượt chơi thứ life, tính thẳng từ seed gốc
+uint64_t levelSeedFor(uint64_t seed, int life);
+// Khoảng cách dọc giữa hai hàng; chia đều chiều cao chunk nên không lớn hơn khoảng cách gốc
+constexpr double chunkRowSpacing(int difficulty) {
+    int verticalGap = (int)(MAX_JUMP_HEIGHT * 0.75 * (1.0f + (difficulty * 0.1f)));
+    int rows = std::min(CHUNK_MAX_PLATFORMS, (CHUNK_HEIGHT + verticalGap - 1) / verticalGap);
+    return (double)CHUNK_HEIGHT / rows;
+}
+void generateChunk(uint64_t seed, int index, int screenWidth, int platformWidth, LevelChunk& out);
+
+// Mọi platform sinh theo chunk có y trong [topY, bottomY], theo y giảm dần. Chỉ sinh các chunk
+// giao với khoảng này, nên chi phí tuỳ vào độ dài khoảng chứ không tuỳ vào độ cao.
+void queryLevel(uint64_t levelSeed, double topY, double bottomY, int screenWidth, int platformWidth,
+                std::vector<LevelPlatform>& out);
+
+#endif // CHUNK_H_INCLUDED
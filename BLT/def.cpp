@@ -1,10 +1,3 @@
 #include "def.h"
 
-const int SCREEN_WIDTH = 450;
-const int SCREEN_HEIGHT = 800;
 const char* WINDOW_TITLE = "Doodle Jump";
-const int MAX_JUMP_HEIGHT = 60;
-const int PLATFORM_WIDTH = 70;
-const int PLATFORM_HEIGHT = 20;
-const int MIN_X_GAP = 50;
-const int MIN_Y_GAP = 30;
@@ -1,14 +1,17 @@
 #ifndef DEF_H_INCLUDED
 #define DEF_H_INCLUDED
 
-extern const int SCREEN_WIDTH;
-extern const int SCREEN_HEIGHT;
+// Hằng số nằm trong header để dùng được trong static_assert và kích thước mảng
+const int SCREEN_WIDTH = 450;
+const int SCREEN_HEIGHT = 800;
 extern const char* WINDOW_TITLE;
-extern const int MAX_JUMP_HEIGHT;
-extern const int PLATFORM_WIDTH;
-extern const int PLATFORM_HEIGHT;
-extern const int MIN_X_GAP;
-extern const int MIN_Y_GAP;
+const int MAX_JUMP_HEIGHT = 60;
+const int PLATFORM_WIDTH = 70;
+const int PLATFORM_HEIGHT = 20;
+const int MIN_X_GAP = 50;
+const int MIN_Y_GAP = 30;
+const int TICK_RATE = 60;
+const int MAX_TICKS_PER_FRAME = 5;
 
 
 
@@ -0,0 +1,128 @@
+#include "env.h"
+#include "def.h"
+#include "rng.h"
+#include <algorithm>
+#include <cmath>
+
+BatchEnv::BatchEnv(int count, uint64_t seed, int threadCount) : pool(threadCount) {
+    count = std::max(count, 0);
+
+    // Mỗi môi trường có seed riêng lấy từ một luồng PCG32 khác nhau của cùng seed gốc
+    worlds.reserve(count);
+    for (int i = 0; i < count; i++) {
+        Rng seedSource(seed, (uint64_t)i);
+        uint64_t worldSeed = ((uint64_t)seedSource.next() << 32) | seedSource.next();
+        worlds.emplace_back(SCREEN_WIDTH, SCREEN_HEIGHT, worldSeed);
+    }
+
+    observations.assign((size_t)count * ENV_OBSERVATION_SIZE, 0.0f);
+    rewards.assign(count, 0.0f);
+    dones.assign(count, 0);
+
+    // Vài khúc mỗi luồng để cân tải khi có thế giới phải sinh thêm platform
+    grain = std::max<size_t>(1, (size_t)count / ((size_t)pool.getThreadCount() * 8));
+
+    for (int i = 0; i < count; i++) {
+        writeObservation(i);
+    }
+}
+
+void BatchEnv::reset() {
+    pool.parallelFor(worlds.size(), grain, [this](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            worlds[i].restart();
+            rewards[i] = 0.0f;
+            dones[i] = 0;
+            writeObservation(i);
+        }
+    });
+}
+
+void BatchEnv::step(const int* actions) {
+    pool.parallelFor(worlds.size(), grain, [this, actions](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            stepOne(i, actions[i]);
+        }
+    });
+}
+
+void BatchEnv::stepOne(size_t index, int action) {
+    World& world = worlds[index];
+    int previousScore = world.getScore();
+
+    InputState input;
+    input.left = action == ENV_ACTION_LEFT;
+    input.right = action == ENV_ACTION_RIGHT;
+    world.tick(input);
+
+    float reward = (world.getScore() - previousScore) / 100.0f;
+    bool done = world.isGameOver();
+    if (done) {
+        reward -= 1.0f;
+        world.restart();
+    }
+
+    rewards[index] = reward;
+    dones[index] = done;
+    writeObservation(index);
+}
+
+void BatchEnv::writeObservation(size_t index) {
+    const World& world = worlds[index];
+    const Player& player = world.getPlayer();
+    const PlatformManager& platformManager = world.getPlatformManager();
+    WorldTuning tuning = world.getTuning();
+
+    float* out = &observations[index * ENV_OBSERVATION_SIZE];
+    std::fill(out, out + ENV_OBSERVATION_SIZE, 0.0f);
+
+    float screenWidth = (float)tuning.screenWidth;
+    float screenHeight = (float)tuning.screenHeight;
+    float playerCenterX = player.getX() + player.getWidth() * 0.5f;
+    double playerY = player.getY();
+
+    out[0] = player.getX() / screenWidth;
+    out[1] = (float)((playerY - world.getCameraY()) / screenHeight);
+    out[2] = player.getVelocityY() / std::fabs(tuning.jumpStrength);
+    out[3] = player.isFacingLeft() ? 1.0f : 0.0f;
+
+    struct Candidate {
+        double distance;
+        PlatformType type;
+        size_t index;
+    };
+
+    // Chỉ xét platform cách người chơi không quá một màn hình; mảng trên stack nên không
+    // có dữ liệu dùng chung giữa các luồng
+    const size_t maxCandidates = 128;
+    Candidate candidates[maxCandidates];
+    size_t candidateCount = 0;
+
+    for (int t = 0; t < PLATFORM_TYPE_COUNT; t++) {
+        PlatformType type = (PlatformType)t;
+        const PlatformLane& lane = platformManager.getLane(type);
+        PlatformRange range = lane.queryRange(playerY - screenHeight, playerY + screenHeight);
+
+        for (size_t i = range.first; i < range.last && candidateCount < maxCandidates; i++) {
+            candidates[candidateCount++] = {std::fabs(lane.getY(i) - playerY), type, i};
+        }
+    }
+
+    size_t nearestCount = std::min<size_t>(candidateCount, ENV_NEAREST_PLATFORMS);
+    std::partial_sort(candidates, candidates + nearestCount, candidates + candidateCount,
+                      [](const Candidate& a, const Candidate& b) { return a.distance < b.distance; });
+
+    float halfPlatformWidth = platformManager.getPlatformWidth() * 0.5f;
+    float* platformOut = out + ENV_PLAYER_FEATURES;
+    for (size_t k = 0; k < nearestCount; k++) {
+        const Candidate& candidate = candidates[k];
+        const PlatformLane& lane = platformManager.getLane(candidate.type);
+
+        platformOut[0] = (lane.getX(candidate.index) + halfPlatformWidth - playerCenterX) / screenWidth;
+        platformOut[1] = (float)((lane.getY(candidate.index) - playerY) / screenHeight);
+        platformOut[2] = platformManager.getVelocityX(candidate.type, candidate.index) / tuning.movingSpeed;
+        platformOut[3] = ((int)candidate.type + 1) / 3.0f;
+        platformOut[4] = lane.isBroken(candidate.index) ? 1.0f : 0.0f;
+        platformOut += ENV_PLATFORM_FEATURES;
+    }
+}
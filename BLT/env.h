@@ -0,0 +1,54 @@
+#ifndef ENV_H_INCLUDED
+#define ENV_H_INCLUDED
+#include <cstdint>
+#include <vector>
+#include "world.h"
+#include "threadpool.h"
+
+enum EnvAction {
+    ENV_ACTION_NONE,
+    ENV_ACTION_LEFT,
+    ENV_ACTION_RIGHT
+};
+
+// Quan sát của mỗi môi trường là một mảng float cố định:
+//   4 số cho người chơi: x / chiều rộng, y trên màn hình / chiều cao, vận tốc dọc / lực nhảy, hướng mặt;
+//   rồi ENV_NEAREST_PLATFORMS platform gần nhất theo chiều dọc, mỗi platform 5 số:
+//   dx, dy (tương đối so với người chơi, đã chuẩn hoá), vận tốc ngang / tốc độ platform,
+//   loại ((type + 1) / 3, bằng 0 nếu ô trống) và cờ đã vỡ.
+const int ENV_NEAREST_PLATFORMS = 8;
+const int ENV_PLAYER_FEATURES = 4;
+const int ENV_PLATFORM_FEATURES = 5;
+const int ENV_OBSERVATION_SIZE = ENV_PLAYER_FEATURES + ENV_NEAREST_PLATFORMS * ENV_PLATFORM_FEATURES;
+
+// N thế giới độc lập chạy song song, không cần SDL, dùng cho bot và huấn luyện RL.
+// Phần thưởng mỗi bước là độ cao mới đạt được (đơn vị 100 pixel), trừ 1 khi rơi.
+// Môi trường nào kết thúc sẽ tự chơi lại ngay, quan sát trả về là của lượt mới.
+class BatchEnv {
+private:
+    std::vector<World> worlds;
+    std::vector<float> observations;
+    std::vector<float> rewards;
+    std::vector<uint8_t> dones;
+    ThreadPool pool;
+    size_t grain;
+
+    void writeObservation(size_t index);
+    void stepOne(size_t index, int action);
+
+public:
+    // threadCount <= 0 dùng mọi nhân của máy
+    BatchEnv(int count, uint64_t seed, int threadCount = 0);
+
+    void reset();
+    void step(const int* actions);
+
+    size_t size() const { return worlds.size(); }
+    const float* getObservations() const { return observations.data(); }
+    const float* getObservation(size_t index) const { return &observations[index * ENV_OBSERVATION_SIZE]; }
+    const float* getRewards() const { return rewards.data(); }
+    const uint8_t* getDones() const { return dones.data(); }
+    const World& getWorld(size_t index) const { return worlds[index]; }
+};
+
+#endif // ENV_H_INCLUDED
@@ -4,29 +4,64 @@
 #include <iostream>
 #include <algorithm>
 #include <SDL_ttf.h>
-#include <fstream>
+#include <cstdio>
 
-Game::Game() {
+// Chữ "Press any key" ở menu nhấp nháy theo chu kỳ này
+static const Uint32 MENU_BLINK_MS = 400;
+// Thời gian ngủ tối đa mỗi lượt ở màn hình tĩnh, để vẫn kiểm tra định kỳ
+static const Uint32 IDLE_WAIT_MS = 250;
+
+Game::Game(uint64_t seed) {
+    this->seed = seed;
+    startHeight = 0.0;
     window = nullptr;
     renderer = nullptr;
     isRunning = false;
-    player = nullptr;
-    platformManager = nullptr;
-
-    menuTexture = nullptr;
-    backgroundTexture = nullptr;
-    playerLeftTexture = nullptr;
-    playerRightTexture = nullptr;
-    platformTexture = nullptr;
-    movingPlatformTexture = nullptr;
-    breakablePlatformTexture = nullptr;
-
-    jumpSound = NULL;
+    world = nullptr;
+    chunkStreamer = nullptr;
+
+    atlas = nullptr;
+    assetLoader = nullptr;
+    spriteBatch = nullptr;
+
+    sounds = new SoundManager(SOUND_COUNT);
+    audioBufferSamples = SoundManager::DEFAULT_BUFFER_SAMPLES;
     font = nullptr;
+    assets = new AssetSource();
+    assetPath = "assets.pak";
+    textRenderer = nullptr;
 
-    score = 0;
     bestScore = 0;
-    cameraThreshold = 300;
+    scoreBoard = new ScoreBoard("scores", "highscore.txt");
+    runTicks = 0;
+
+    profiler = new Profiler();
+    simProfiler = new Profiler();
+    simProfiler->setThreadId(2);
+    showProfiler = false;
+
+    replay = new Replay();
+    recordPath = "lastrun.bltr";
+    isRecording = false;
+    isPlayback = false;
+    playbackSpeed = 1.0f;
+    pendingMute = false;
+
+    renderBuffer = new TripleBuffer<RenderState>();
+    countsPerTick = 1;
+    inputTimeline = new InputTimeline();
+    muteRequests = 0;
+    retryRequested = false;
+
+    publishedGameOver = false;
+    framePacer = new FramePacer();
+    simPacer = new FramePacer();
+    frameRateLimit = -1.0;
+    shownScreenKey = 0;
+
+    latencyMode = false;
+    lastShownPress = 0;
+    latencyCount = 0;
 
     isOnMenu = true;
     isMuted = false;
@@ -34,19 +69,41 @@ Game::Game() {
 }
 
 Game::~Game() {
-    if (playerLeftTexture) SDL_DestroyTexture(playerLeftTexture);
-    if (playerRightTexture) SDL_DestroyTexture(playerRightTexture);
-    if (platformTexture) SDL_DestroyTexture(platformTexture);
-    if (movingPlatformTexture) SDL_DestroyTexture(movingPlatformTexture);
-    if (breakablePlatformTexture) SDL_DestroyTexture(breakablePlatformTexture);
-    if (backgroundTexture) SDL_DestroyTexture(backgroundTexture);
-    if (jumpSound) Mix_FreeChunk(jumpSound);
+    if (simThread.joinable()) {
+        isRunning = false;
+        wakeSimulation();
+        simThread.join();
+    }
+
+    if (!tracePath.empty()) profiler->writeTrace(tracePath, simProfiler);
+    delete profiler;
+    delete simProfiler;
+    delete renderBuffer;
+    delete inputTimeline;
+    // Chờ luồng ghi điểm xong rồi mới thoát
+    delete scoreBoard;
+    delete framePacer;
+    delete simPacer;
+
+    if (isRecording && replay->getTickCount() > 0 && !recordPath.empty()) {
+        replay->save(recordPath);
+    }
+    delete replay;
+
+    // Dừng các luồng giải mã trước khi đóng gói tài nguyên và âm thanh
+    delete assetLoader;
+    delete sounds;
+    delete atlas;
+    delete textRenderer;
+    delete spriteBatch;
     if (font) TTF_CloseFont(font);
 
     TTF_Quit();
+    // Font đọc thẳng từ vùng map nên gói phải đóng sau cùng
+    delete assets;
 
-    delete player;
-    delete platformManager;
+    delete world;
+    delete chunkStreamer;
 
     quitSDL(window, renderer);
 }
@@ -63,249 +120,730 @@ bool Game::init() {
         return false;
     }
 
-    if (!initAudio()) {
+    if (!sounds->open(audioBufferSamples)) {
         std::cerr << "Failed to initialize audio!" << std::endl;
         return false;
     }
+    sounds->setMeasuring(latencyMode);
 
     if (TTF_Init() == -1) {
         std::cerr << "SDL_ttf could not initialize! TTF Error: " << TTF_GetError() << std::endl;
         return false;
     }
-    font = TTF_OpenFont("./font/font.ttf", 30);
+    // Giải mã ảnh và âm thanh chạy song song với phần khởi tạo còn lại
+    assets->openArchive(assetPath);
+    requestAssets();
+
+    font = TTF_OpenFontRW(assets->open("font/font.ttf"), 1, 30);
     if (!font) {
         std::cerr << "Failed to load font! TTF Error: " << TTF_GetError() << std::endl;
         return false;
     }
+    spriteBatch = new SpriteBatch();
+    textRenderer = new TextRenderer();
+    if (!textRenderer->init(renderer, font, spriteBatch)) {
+        std::cerr << "Failed to build glyph atlas!" << std::endl;
+        return false;
+    }
 
-    loadTextures();
-    loadSounds();
+    atlas = new TextureAtlas();
+    if (!atlas->init(renderer, SPRITE_COUNT)) {
+        std::cerr << "Failed to build sprite atlas!" << std::endl;
+        return false;
+    }
 
-    player = new Player(SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2, 80);
-    player->setTexture(playerLeftTexture);
-    player->setJumpSound(jumpSound);
+    world = new World(SCREEN_WIDTH, SCREEN_HEIGHT, seed);
+    world->setProfiler(simProfiler);
 
-    platformManager = new PlatformManager(SCREEN_WIDTH, SCREEN_HEIGHT);
-    platformManager->setTextures(platformTexture, movingPlatformTexture, breakablePlatformTexture);
-    platformManager->initialize(10);
+    // Sinh trước các chunk phía trên camera trên luồng nền
+    chunkStreamer = new ChunkStreamer(SCREEN_WIDTH, PLATFORM_WIDTH);
+    world->setChunkStreamer(chunkStreamer);
+
+    if (startHeight > 0.0) {
+        world->setStartHeight(startHeight);
+        world->restart();
+    }
+
+    if (isPlayback) {
+        if (!replay->matchesTuning(world->getTuning())) {
+            std::cerr << "Replay was recorded with different game constants and would not play back the same!" << std::endl;
+            return false;
+        }
+    } else {
+        replay->startRecording(seed, startHeight, world->getTuning());
+        isRecording = true;
+    }
 
     isRunning = true;
-    loadBestScore();
+    scoreBoard->load();
+    bestScore = scoreBoard->getBestScore();
+
+    // Chỉ chờ ảnh menu; phần còn lại được đưa lên texture trong vòng lặp chính khi tới.
+    // Phát lại thì vào chơi ngay nên phải chờ đủ.
+    LoadedAsset asset;
+    while (isOnMenu ? !atlas->hasRegion(SPRITE_MENU) : !assetLoader->isDone()) {
+        if (!assetLoader->wait(asset)) break;
+        receiveAsset(asset);
+    }
     return true;
 }
 
-void Game::loadTextures() {
-    menuTexture = loadTexture("./images/menu.png", renderer);
-    backgroundTexture = loadTexture("./images/background .png", renderer);
-    playerLeftTexture = loadTexture("./images/playerleft.png", renderer);
-    playerRightTexture = loadTexture("./images/playerright.png", renderer);
-    platformTexture = loadTexture("./images/platform.png", renderer);
-    movingPlatformTexture = loadTexture("./images/movingplatform.png", renderer);
-    breakablePlatformTexture = loadTexture("./images/brown_platform_breaking_.png", renderer);
+// Gửi theo thứ tự cần dùng: ảnh menu trước tiên
+void Game::requestAssets() {
+    static const char* const spriteFiles[SPRITE_COUNT] = {
+        "images/menu.png",
+        "images/background .png",
+        "images/playerleft.png",
+        "images/playerright.png",
+        "images/platform.png",
+        "images/movingplatform.png",
+        "images/brown_platform_breaking_.png"
+    };
+    static const char* const soundFiles[SOUND_COUNT] = {
+        "sound/jumpSound.mp3",
+        "sound/fallSound.mp3"
+    };
+
+    assetLoader = new AssetLoader(*assets);
+    for (int i = 0; i < SPRITE_COUNT; i++) {
+        assetLoader->requestImage(i, spriteFiles[i]);
+    }
+    for (int i = 0; i < SOUND_COUNT; i++) {
+        assetLoader->requestSound(i, soundFiles[i]);
+    }
+}
+
+void Game::receiveAsset(LoadedAsset& asset) {
+    if (asset.kind == ASSET_IMAGE) {
+        if (asset.surface) {
+            atlas->add(asset.id, asset.surface);
+            SDL_FreeSurface(asset.surface);
+        } else {
+            std::cerr << "Failed to load image " << asset.name << std::endl;
+        }
+    } else if (asset.sound) {
+        sounds->setSound(asset.id, asset.sound);
+    } else {
+        std::cerr << "Failed to load sound " << asset.name << std::endl;
+    }
 }
 
-void Game::loadSounds() {
-    jumpSound = Mix_LoadWAV("./sound/jumpSound.mp3");
-    if (!jumpSound) {
-        std::cerr << "Failed to load jump sound! SDL_mixer Error: " << Mix_GetError() << std::endl;
+// Đưa lên texture những gì đã giải mã xong từ frame trước; mỗi ảnh chỉ cập nhật đúng vùng của nó
+void Game::receiveAssets() {
+    LoadedAsset asset;
+    while (assetLoader->poll(asset)) {
+        receiveAsset(asset);
     }
+}
 
+// waitMs > 0 thì ngủ chờ sự kiện đầu tiên tối đa chừng ấy ms thay vì chỉ hỏi một lượt.
+// Trả về true nếu đã xử lý ít nhất một sự kiện.
+bool Game::handleEvents(Uint32 waitMs) {
+    SDL_Event e;
+    bool hasEvent = waitMs > 0 ? SDL_WaitEventTimeout(&e, (int)waitMs) != 0 : SDL_PollEvent(&e) != 0;
+    bool handled = false;
 
+    while (hasEvent) {
+        handled = true;
+        if (!handleEvent(e)) break;
+        hasEvent = SDL_PollEvent(&e) != 0;
+    }
+    return handled;
 }
 
-void Game::handleEvents() {
-    SDL_Event e;
+// Trả về false khi cần dừng xử lý các sự kiện còn lại của frame này
+bool Game::handleEvent(const SDL_Event& e) {
+    if ((e.type == SDL_KEYDOWN || e.type == SDL_KEYUP) && !e.key.repeat) {
+        pushKeyEvent(e.key);
+    }
 
-    while (SDL_PollEvent(&e)) {
-        if (e.type == SDL_QUIT) {
+    if (e.type == SDL_QUIT) {
+        isRunning = false;
+        wakeSimulation();
+    }
+    else if (e.type == SDL_KEYDOWN) {
+        if (e.key.keysym.sym == SDLK_ESCAPE) {
             isRunning = false;
+            wakeSimulation();
         }
-        else if (e.type == SDL_KEYDOWN) {
-            if (e.key.keysym.sym == SDLK_ESCAPE) {
-                isRunning = false;
-            }
-            if (e.key.keysym.sym == SDLK_m) {
-                isMuted = !isMuted;
-                int volume = isMuted ? 0 : MIX_MAX_VOLUME;
-                Mix_Volume(-1, volume);
-                Mix_VolumeChunk(jumpSound, volume);
-            }
-            if (isOnMenu) {
-                isOnMenu = false;
-                return;
-            }
-        } else if (e.type == SDL_MOUSEBUTTONDOWN) {
-            if (isOnMenu) {
-                isOnMenu = false;
-                return;
-            }
+        if (e.key.keysym.sym == SDLK_F3) {
+            showProfiler = !showProfiler;
+            return true;
+        }
+        // Khi phát lại, bật/tắt tiếng lấy từ file replay
+        if (e.key.keysym.sym == SDLK_m && !isPlayback) {
+            muteRequests++;
+            wakeSimulation();
+        }
+        // Chỉ bấm R khi luồng mô phỏng đã báo thua qua trạng thái vẽ
+        if (e.key.keysym.sym == SDLK_r && renderBuffer->readSlot().gameOver) {
+            retryRequested = true;
+            wakeSimulation();
         }
+        // Chưa giải mã xong ảnh của màn chơi thì ở lại menu
+        if (isOnMenu && assetLoader->isDone()) {
+            isOnMenu = false;
+            wakeSimulation();
+            return false;
+        }
+    } else if (e.type == SDL_MOUSEBUTTONDOWN) {
+        if (isOnMenu && assetLoader->isDone()) {
+            isOnMenu = false;
+            wakeSimulation();
+            return false;
+        }
+    }
+    return true;
+}
+
+// Khoá rồi mới báo để luồng mô phỏng không lỡ tín hiệu giữa lúc kiểm tra điều kiện và lúc ngủ
+void Game::wakeSimulation() {
+    {
+        std::lock_guard<std::mutex> lock(simWakeMutex);
+    }
+    simWake.notify_one();
+}
+
+// Phím di chuyển đi thẳng sang luồng mô phỏng kèm thời điểm nhấn/nhả, thay vì đọc
+// SDL_GetKeyboardState mỗi frame và bỏ lỡ những cú bấm nhanh giữa hai frame
+void Game::pushKeyEvent(const SDL_KeyboardEvent& key) {
+    // Khi phát lại, input lấy từ file replay; phím thật không được lọt vào hàng đợi
+    if (isPlayback) return;
+
+    KeyEvent event;
+    if (key.keysym.scancode == SDL_SCANCODE_LEFT) event.key = INPUT_KEY_LEFT;
+    else if (key.keysym.scancode == SDL_SCANCODE_RIGHT) event.key = INPUT_KEY_RIGHT;
+    else return;
+
+    // timestamp của SDL tính bằng ms theo SDL_GetTicks; đổi sang bộ đếm hiệu năng mà các tick dùng.
+    // Quá 100 ms thì coi như đồng hồ lệch và lấy thời điểm hiện tại.
+    Uint64 now = SDL_GetPerformanceCounter();
+    Uint32 ageMs = SDL_GetTicks() - key.timestamp;
+    Uint64 age = ageMs <= 100 ? ageMs * SDL_GetPerformanceFrequency() / 1000 : 0;
+
+    event.time = now - std::min(age, now);
+    event.down = key.type == SDL_KEYDOWN;
+    if (!inputTimeline->push(event)) {
+        std::cerr << "Input queue is full, dropped a key event" << std::endl;
     }
+}
+
+void Game::update(Uint64 tickEnd) {
+    // Vẫn lấy sự kiện phím khi đang ở menu để biết phím nào đang được giữ
+    InputState liveInput{};
+    if (!isPlayback) liveInput = inputTimeline->sample(tickEnd - countsPerTick, tickEnd);
 
-    if (isOnMenu) return;
+    if (isOnMenu || isGameOver) return;
+
+    InputState input;
+    if (isPlayback) {
+        uint16_t bits;
+        if (!replay->next(bits)) {
+            finishPlayback();
+            return;
+        }
+        input = Replay::toInputState(bits);
+        if (bits & REPLAY_INPUT_MUTE) toggleMute();
+    } else {
+        input = liveInput;
+        uint16_t bits = Replay::fromInputState(input);
+        if (pendingMute) bits |= REPLAY_INPUT_MUTE;
+        pendingMute = false;
+        if (isRecording) replay->record(bits);
+    }
 
-    const Uint8* keystates = SDL_GetKeyboardState(NULL);
+    world->tick(input);
+    runTicks++;
 
-    if (!player->getIsJumping()) {
-        player->jump();
+    bool skipRender = isPlayback && playbackSpeed <= 0.0f;
+    // Phát ngay trong tick xảy ra sự kiện; hình của tick đó lên màn hình sau chừng một frame,
+    // nên bộ đệm âm thanh nhỏ là đủ để tiếng và hình khớp nhau
+    if (!skipRender) {
+        if (world->getEvents() & WORLD_EVENT_JUMP) sounds->play(SOUND_JUMP);
+        if (world->getEvents() & WORLD_EVENT_FALL) sounds->play(SOUND_FALL);
     }
 
-    if (keystates[SDL_SCANCODE_RIGHT]) {
-        player->moveRight();
-        player->setTexture(playerRightTexture);
+    // Lượt luyện tập bắt đầu giữa chừng nên không tính vào điểm cao
+    if (startHeight <= 0.0) {
+        bestScore = std::max(world->getScore(), bestScore);
     }
 
-    if (keystates[SDL_SCANCODE_LEFT]) {
-        player->moveLeft();
-        player->setTexture(playerLeftTexture);
+    if (world->isGameOver() && isPlayback) {
+        // Phát lại không chờ người chơi bấm R và không ghi đè điểm cao
+        world->restart();
+        runTicks = 0;
+    }
+    else if (world->isGameOver()) {
+        {
+            ProfileScope scope(simProfiler, PHASE_SAVE_SCORE);
+            saveRun();
+        }
+        // Chờ người chơi bấm R; luồng chính vẽ màn hình thua từ trạng thái đã gửi
+        isGameOver = true;
     }
 }
 
-void Game::update() {
-    if (isOnMenu || isGameOver) return;
+void Game::simulationLoop() {
+    const Uint64 maxLagCounts = countsPerTick * MAX_TICKS_PER_FRAME;
+
+    Uint64 nextTick = SDL_GetPerformanceCounter();
+
+    while (isRunning) {
+        if (muteRequests.exchange(0) & 1) {
+            toggleMute();
+            pendingMute = !pendingMute;
+        }
+
+        Uint64 now = SDL_GetPerformanceCounter();
+
+        // Ở menu hay màn hình thua thì không có gì để tick: chỉ lấy bớt sự kiện phím rồi ngủ tới khi
+        // luồng chính gọi (rời menu, bấm R, bật/tắt tiếng, thoát), thay vì thức dậy 60 lần mỗi giây
+        if ((isOnMenu || isGameOver) && !retryRequested) {
+            inputTimeline->sample(now - countsPerTick, now);
+
+            std::unique_lock<std::mutex> lock(simWakeMutex);
+            simWake.wait_for(lock, std::chrono::milliseconds(IDLE_WAIT_MS), [this] {
+                return !isRunning || muteRequests != 0 || retryRequested || (!isOnMenu && !isGameOver);
+            });
+            nextTick = SDL_GetPerformanceCounter();
+            continue;
+        }
 
-    player->update(platformManager->getPlatforms());
-    platformManager->update();
-    platformManager->updateDifficulty(score);
+        // Bị treo quá lâu (máy ngủ, debugger) thì bỏ phần thời gian nợ thay vì chạy bù
+        if (now > nextTick + maxLagCounts) nextTick = now - maxLagCounts;
+
+        if (now >= nextTick) {
+            simProfiler->beginFrame();
+            {
+                std::lock_guard<std::mutex> lock(worldMutex);
+                if (isGameOver && retryRequested.exchange(false)) {
+                    isGameOver = false;
+                    world->restart();
+                    runTicks = 0;
+                }
+
+                // Mỗi tick lấy input ngay trước khi chạy, phủ đúng khoảng thời gian của nó
+                while (now >= nextTick && isRunning) {
+                    ProfileScope scope(simProfiler, PHASE_UPDATE);
+                    update(nextTick);
+                    nextTick += countsPerTick;
+                }
+                publishRenderState(nextTick - countsPerTick);
+            }
+            simProfiler->endFrame();
+        }
 
-    if (player->getY() < cameraThreshold) {
-        int scrollAmount = cameraThreshold - player->getY();
-        player->setPosition(player->getX(), cameraThreshold);
-        platformManager->scrollPlatforms(scrollAmount);
-        score += scrollAmount;
-        bestScore = std::max(score, bestScore);
-        platformManager->removeBottomPlatforms();
-        int platformsToAdd = platformManager->getPlatformsToGenerate();
-        platformManager->addNewPlatforms(platformsToAdd);
+        Uint64 remaining = nextTick - std::min(nextTick, SDL_GetPerformanceCounter());
+        simPacer->waitFor((double)remaining / SDL_GetPerformanceFrequency());
     }
+}
 
-    if (player->getY() > SCREEN_HEIGHT) {
-        saveBestScore();
-        handleGameOverScreen();
+void Game::publishRenderState(uint64_t tickCounter) {
+    RenderState& state = renderBuffer->writeSlot();
+    captureRenderState(*world, state);
+    state.tickCounter = tickCounter;
+    state.bestScore = bestScore;
+    state.muted = isMuted;
+    state.gameOver = isGameOver;
+    state.lastPressCounter = inputTimeline->getLastPressTime();
+
+    // Luồng chính có thể đang ngủ chờ sự kiện ở màn hình thua; gửi một sự kiện để nó vẽ lại ngay
+    if (publishedGameOver && !isGameOver) {
+        SDL_Event wake;
+        SDL_zero(wake);
+        wake.type = SDL_USEREVENT;
+        SDL_PushEvent(&wake);
     }
+    publishedGameOver = isGameOver;
+
+    if (showProfiler) {
+        for (int i = 0; i < PHASE_COUNT; i++) {
+            state.simStats[i] = simProfiler->getStats((ProfilePhase)i);
+        }
+    }
+    renderBuffer->publish();
 }
 
-void Game::render() {
+void Game::render(const RenderState& state, float alpha) {
     SDL_RenderClear(renderer);
 
     if (isOnMenu) {
-        SDL_RenderCopy(renderer, menuTexture, NULL, NULL);
+        ProfileScope scope(profiler, PHASE_RENDER_BACKGROUND);
+        drawBackground(SPRITE_MENU);
         Uint32 time = SDL_GetTicks();
-        if(time / 400 % 2 == 0) {
-            displayText("Press any key", SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 + 20);
-            displayText("to play", SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 + 50);
+        if (!assetLoader->isDone()) {
+            displayCachedText("Loading...", SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 + 20);
+        }
+        else if(time / MENU_BLINK_MS % 2 == 0) {
+            displayCachedText("Press any key", SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 + 20);
+            displayCachedText("to play", SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 + 50);
         }
+        spriteBatch->flush(renderer);
         SDL_RenderPresent(renderer);
         return;
     }
 
-    if (backgroundTexture) {
-        SDL_RenderCopy(renderer, backgroundTexture, NULL, NULL);
+    if (state.gameOver) {
+        renderGameOver(state);
+        return;
     }
 
-    platformManager->render(renderer);
-    player->render(renderer);
-    displayText("Score: " + std::to_string(score), 280, 10);
+    {
+        ProfileScope scope(profiler, PHASE_RENDER_BACKGROUND);
+        drawBackground(SPRITE_BACKGROUND);
+    }
+    {
+        ProfileScope scope(profiler, PHASE_RENDER_PLATFORMS);
+        renderPlatforms(state, alpha);
+    }
+    {
+        ProfileScope scope(profiler, PHASE_RENDER_PLAYER);
+        renderPlayer(state, alpha);
+    }
+    {
+        ProfileScope scope(profiler, PHASE_RENDER_TEXT);
+        displayText("Score: " + std::to_string(state.score), 280, 10);
 
-    std::string soundStatus = isMuted ? "Sound: Off" : "Sound: On";
-    displayText(soundStatus, 10, 10);
+        std::string soundStatus = state.muted ? "Sound: Off" : "Sound: On";
+        displayCachedText(soundStatus, 10, 10);
 
-    SDL_RenderPresent(renderer);
+        if (showProfiler) renderProfiler(state);
+        if (latencyMode) renderLatency(state);
+    }
 
-    if (isGameOver) {
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
-    SDL_RenderClear(renderer);
+    {
+        ProfileScope scope(profiler, PHASE_RENDER_PRESENT);
+        spriteBatch->flush(renderer);
+        SDL_RenderPresent(renderer);
+    }
+}
 
-    displayText("Game Over!", SCREEN_WIDTH / 2 - 80, SCREEN_HEIGHT / 2 - 40);
-    displayText("Press any key to retry", SCREEN_WIDTH / 2 - 130, SCREEN_HEIGHT / 2);
-    displayText("Best Score: " + std::to_string(bestScore), SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 + 40);
+void Game::renderGameOver(const RenderState& state) {
+    drawBackground(SPRITE_BACKGROUND);
 
-    SDL_RenderPresent(renderer);
-    SDL_Delay(100);
-    return;
-}
+    displayCachedText("Game Over!", SCREEN_WIDTH / 2 - 60, SCREEN_HEIGHT / 2 - 80);
+    displayCachedText("Press R to retry", SCREEN_WIDTH / 2 - 90, SCREEN_HEIGHT / 2 - 40);
+    displayText("Best Score: " + std::to_string(state.bestScore), SCREEN_WIDTH / 2 - 90, SCREEN_HEIGHT / 2 );
 
+    spriteBatch->flush(renderer);
+    SDL_RenderPresent(renderer);
 }
 
 void Game::run() {
+    if (isPlayback && playbackSpeed <= 0.0f) {
+        runUncapped();
+        return;
+    }
+
+    const double speed = isPlayback ? playbackSpeed : 1.0;
+    countsPerTick = std::max<Uint64>((Uint64)(SDL_GetPerformanceFrequency() / (TICK_RATE * speed)), 1);
+
+    // Có VSync thì SDL_RenderPresent đã giữ nhịp; không có thì tự giới hạn theo tần số quét màn hình
+    if (frameRateLimit < 0.0) {
+        SDL_RendererInfo info;
+        SDL_DisplayMode mode;
+        bool hasVSync = SDL_GetRendererInfo(renderer, &info) == 0 && (info.flags & SDL_RENDERER_PRESENTVSYNC);
+        bool hasMode = SDL_GetCurrentDisplayMode(0, &mode) == 0 && mode.refresh_rate > 0;
+        framePacer->setTargetRate(hasVSync ? 0.0 : (hasMode ? mode.refresh_rate : 60.0));
+    } else {
+        framePacer->setTargetRate(frameRateLimit);
+    }
+
+    // Gửi sẵn trạng thái đầu tiên để frame đầu có gì mà vẽ
+    publishRenderState(SDL_GetPerformanceCounter());
+    simThread = std::thread(&Game::simulationLoop, this);
+
+    Uint32 idleWaitMs = 0;
     while (isRunning) {
-        handleEvents();
-        update();
-        render();
-        SDL_Delay(0);
+        profiler->beginFrame();
+        bool hadEvents;
+        {
+            ProfileScope scope(profiler, PHASE_EVENTS);
+            hadEvents = handleEvents(idleWaitMs);
+        }
+        receiveAssets();
+
+        renderBuffer->acquire();
+        const RenderState& state = renderBuffer->readSlot();
+
+        // Menu và màn hình thua chỉ vẽ lại khi có sự kiện hoặc nội dung đổi; còn lại ngủ chờ
+        bool staticScreen = isOnMenu || state.gameOver;
+        Uint32 nowMs = SDL_GetTicks();
+        uint64_t screenKey = staticScreen ? staticScreenKey(state, nowMs) : 0;
+        if (staticScreen && !hadEvents && screenKey == shownScreenKey) {
+            idleWaitMs = isOnMenu ? MENU_BLINK_MS - nowMs % MENU_BLINK_MS : IDLE_WAIT_MS;
+            profiler->endFrame();
+            continue;
+        }
+        idleWaitMs = 0;
+        shownScreenKey = screenKey;
+
+        // Vẽ chậm hơn tick mới nhất một khoảng alpha; quá một tick thì đứng yên ở tick đó
+        double sinceTick = (double)SDL_GetPerformanceCounter() - (double)state.tickCounter;
+        float alpha = (float)std::min(std::max(sinceTick / countsPerTick, 0.0), 1.0);
+
+        {
+            ProfileScope scope(profiler, PHASE_RENDER);
+            render(state, alpha);
+        }
+        if (latencyMode) recordLatency(state);
+        profiler->endFrame();
+        framePacer->waitForNextFrame();
     }
+
+    simThread.join();
+    if (latencyMode) printLatencySummary();
 }
 
-void Game::displayText(const std::string& text, int x, int y, SDL_Color color) {
-    if (!font) return;
-    SDL_Surface* textSurface = TTF_RenderText_Blended(font, text.c_str(), color);
-    if (!textSurface) {
-        std::cerr << "Unable to render text surface! SDL_ttf Error: " << TTF_GetError() << std::endl;
-        return;
-    }
-    SDL_Texture* textTexture = SDL_CreateTextureFromSurface(renderer, textSurface);
-    if (!textTexture) {
-        std::cerr << "Unable to create texture from rendered text! SDL Error: " << SDL_GetError() << std::endl;
-        SDL_FreeSurface(textSurface);
-        return;
+// Những gì quyết định hình của menu và màn hình thua; giống nhau thì khỏi vẽ lại
+uint64_t Game::staticScreenKey(const RenderState& state, Uint32 nowMs) const {
+    if (isOnMenu) return 1 | (uint64_t)(nowMs / MENU_BLINK_MS % 2) << 1 | (uint64_t)assetLoader->isDone() << 2;
+    return 4 | (uint64_t)(uint32_t)state.bestScore << 3;
+}
+
+void Game::renderPlatforms(const RenderState& state, float alpha) {
+    static const int laneSprites[PLATFORM_TYPE_COUNT] = {
+        SPRITE_PLATFORM,
+        SPRITE_MOVING_PLATFORM,
+        SPRITE_BREAKABLE_PLATFORM
+    };
+
+    double cameraY = state.prevCameraY + (state.cameraY - state.prevCameraY) * alpha;
+
+    for (int i = 0; i < state.platformCount; i++) {
+        const RenderPlatform& platform = state.platforms[i];
+        int sprite = atlas->hasRegion(laneSprites[platform.type]) ? laneSprites[platform.type] : SPRITE_PLATFORM;
+
+        SDL_FRect drawRect = {
+            platform.prevX + (platform.x - platform.prevX) * alpha,
+            (float)(platform.prevY + (platform.y - platform.prevY) * alpha - cameraY),
+            (float)state.platformWidth,
+            (float)state.platformHeight
+        };
+
+        if (!drawSprite(sprite, drawRect)) {
+            spriteBatch->draw(atlas->getTexture(), atlas->getWhiteRegion(), drawRect, {100, 100, 255, 255});
+        }
     }
-    SDL_Rect renderQuad = { x, y, textSurface->w, textSurface->h };
-    SDL_RenderCopy(renderer, textTexture, NULL, &renderQuad);
+}
 
-    SDL_FreeSurface(textSurface);
-    SDL_DestroyTexture(textTexture);
+void Game::renderPlayer(const RenderState& state, float alpha) {
+    float drawX = state.playerPrevX + (state.playerX - state.playerPrevX) * alpha;
+    double cameraY = state.prevCameraY + (state.cameraY - state.prevCameraY) * alpha;
+    float drawY = (float)(state.playerPrevY + (state.playerY - state.playerPrevY) * alpha - cameraY);
+    SDL_FRect destRect = {drawX, drawY - state.playerHeight, (float)state.playerWidth, (float)state.playerHeight};
+    drawSprite(state.facingLeft ? SPRITE_PLAYER_LEFT : SPRITE_PLAYER_RIGHT, destRect);
 }
 
-void Game::saveBestScore() {
-    std::ofstream outFile("highscore.txt");
-    if (outFile.is_open()) {
-        outFile << bestScore;
-        outFile.close();
-    } else {
-        std::cerr << "Failed to save high score!" << std::endl;
+bool Game::drawSprite(int sprite, const SDL_FRect& dest) {
+    if (!atlas->hasRegion(sprite)) return false;
+
+    spriteBatch->draw(atlas->getTexture(), atlas->getRegion(sprite), dest);
+    return true;
+}
+
+void Game::drawBackground(int sprite) {
+    SDL_FRect dest = {0, 0, (float)SCREEN_WIDTH, (float)SCREEN_HEIGHT};
+    drawSprite(sprite, dest);
+}
+
+// Bảng thời gian từng pha (F3), vẽ chung batch nên không tốn thêm draw call
+void Game::renderProfiler(const RenderState& state) {
+    const int lineHeight = 16;
+    const float textScale = 0.5f;
+
+    SDL_FRect panel = {0, 40, 290, (float)(PHASE_COUNT + 1) * lineHeight + 8};
+    spriteBatch->draw(atlas->getTexture(), atlas->getWhiteRegion(), panel, {255, 255, 255, 200});
+
+    int y = 44;
+    textRenderer->draw("phase             p50    p99    max (ms)", 6, y, {0, 0, 0, 255}, textScale);
+    for (int i = 0; i < PHASE_COUNT; i++) {
+        y += lineHeight;
+        ProfilePhase phase = (ProfilePhase)i;
+        bool simPhase = (phase >= PHASE_UPDATE && phase <= PHASE_UPDATE_CAMERA) || phase == PHASE_SAVE_SCORE;
+        PhaseStats stats = simPhase ? state.simStats[phase] : profiler->getStats(phase);
+
+        char line[64];
+        std::snprintf(line, sizeof(line), "%-14s %6.3f %6.3f %6.3f",
+                      Profiler::getPhaseName(phase), stats.p50, stats.p99, stats.max);
+        textRenderer->draw(line, 6, y, {0, 0, 0, 255}, textScale);
     }
 }
 
-void Game::loadBestScore() {
-    std::ifstream inFile("highscore.txt");
-    if (inFile.is_open()) {
-        inFile >> bestScore;
-        inFile.close();
-    } else {
-        bestScore = 0;
+void Game::setAssetPath(const std::string& path) {
+    assetPath = path;
+}
+
+void Game::setTracePath(const std::string& path) {
+    tracePath = path;
+    // Gọi trước run() nên luồng mô phỏng chưa chạy
+    profiler->setTracing(!path.empty());
+    simProfiler->setTracing(!path.empty());
+}
+
+void Game::displayText(const std::string& text, int x, int y, SDL_Color color) {
+    textRenderer->draw(text, x, y, color);
+}
+
+void Game::displayCachedText(const std::string& text, int x, int y, SDL_Color color) {
+    textRenderer->drawCached(text, x, y, color);
+}
+
+// Chỉ cập nhật bảng trong bộ nhớ; luồng ghi của ScoreBoard lo phần ổ đĩa
+void Game::saveRun() {
+    // Lượt luyện tập không vào bảng điểm
+    if (startHeight > 0.0) return;
+
+    ScoreEntry entry = {};
+    entry.score = world->getScore();
+    entry.seed = seed;
+    entry.durationTicks = runTicks;
+    // Độ khó chỉ tăng theo độ cao nên lúc thua cũng là lúc khó nhất
+    entry.maxDifficulty = world->getDifficultyLevel();
+    scoreBoard->submit(entry);
+}
+
+// Phát lại nhanh nhất có thể, không vẽ gì; dùng làm tải đo hiệu năng lặp lại được
+void Game::runUncapped() {
+    const double counterFrequency = (double)SDL_GetPerformanceFrequency();
+    Uint64 startCounter = SDL_GetPerformanceCounter();
+    uint64_t ticks = 0;
+
+    while (isRunning) {
+        if ((ticks & 1023) == 0) handleEvents();
+        update(0);
+        ticks++;
     }
+
+    double seconds = (SDL_GetPerformanceCounter() - startCounter) / counterFrequency;
+    std::cout << "Replayed " << ticks << " ticks in " << seconds << " s ("
+              << (seconds > 0.0 ? ticks / seconds : 0.0) << " ticks/s)" << std::endl;
 }
 
-void Game::handleGameOverScreen() {
-    SDL_Event e;
-    bool waiting = true;
+void Game::finishPlayback() {
+    std::cout << "Replay finished: score " << world->getScore() << ", best " << bestScore << std::endl;
+    isRunning = false;
+}
 
-    while (waiting) {
-        SDL_RenderCopy(renderer, backgroundTexture, NULL, NULL);
+void Game::toggleMute() {
+    isMuted = !isMuted;
+    sounds->setMuted(isMuted);
+}
 
-        displayText("Game Over!", SCREEN_WIDTH / 2 - 60, SCREEN_HEIGHT / 2 - 80);
-        displayText("Press R to retry", SCREEN_WIDTH / 2 - 90, SCREEN_HEIGHT / 2 - 40);
-        displayText("Best Score: " + std::to_string(bestScore), SCREEN_WIDTH / 2 - 90, SCREEN_HEIGHT / 2 );
+void Game::setRecordPath(const std::string& path) {
+    recordPath = path;
+}
 
-        SDL_RenderPresent(renderer);
+bool Game::loadReplay(const std::string& path, float speed) {
+    if (!replay->load(path)) return false;
 
-        while (SDL_PollEvent(&e)) {
-            if (e.type == SDL_QUIT) {
-                isRunning = false;
-                waiting = false;
-            }
-            else if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_r) {
-                waiting = false;
-            }
+    seed = replay->getSeed();
+    startHeight = replay->getStartHeight();
+    isPlayback = true;
+    playbackSpeed = speed;
+    isOnMenu = false;
+    std::cout << "Replaying " << replay->getTickCount() << " ticks from " << path
+              << " (seed " << seed << ")" << std::endl;
+    return true;
+}
+
+bool Game::snapshot(WorldSnapshot& out) const {
+    std::lock_guard<std::mutex> lock(worldMutex);
+    return world && world->snapshot(out);
+}
+
+bool Game::restore(const WorldSnapshot& in) {
+    if (isPlayback) {
+        std::cerr << "Cannot restore a snapshot while a replay is playing!" << std::endl;
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(worldMutex);
+        if (!world || !world->restore(in)) {
+            std::cerr << "Failed to restore game snapshot!" << std::endl;
+            return false;
+        }
+
+        // Trạng thái có thể đến từ phiên khác hay độ cao bất kỳ nên không lưu điểm và không cập nhật điểm cao
+        isGameOver = world->isGameOver();
+        retryRequested = false;
+        runTicks = 0;
+        if (isRecording) {
+            isRecording = false;
+            std::cerr << "Stopped recording the replay: a snapshot was restored" << std::endl;
         }
 
-        SDL_Delay(0);
+        // Luồng mô phỏng có thể đang ngủ ở màn hình thua nên tự gửi trạng thái mới cho luồng vẽ
+        publishRenderState(SDL_GetPerformanceCounter());
     }
+    wakeSimulation();
+    return true;
+}
 
-    // Reset trạng thái game
-    isGameOver = false;
-    score = 0;
-    player->setPosition(SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2);
-    platformManager->initialize(15);
+void Game::setStartHeight(double height) {
+    startHeight = std::max(height, 0.0);
 }
 
+void Game::setLatencyMode(bool enabled) {
+    latencyMode = enabled;
+}
+
+void Game::setFrameRateLimit(double limit) {
+    frameRateLimit = limit;
+}
+
+void Game::setAudioBufferSize(int samples) {
+    audioBufferSamples = samples;
+}
+
+static float latencyPercentile(std::vector<float> samples, float fraction) {
+    if (samples.empty()) return 0.0f;
+    size_t index = (size_t)((samples.size() - 1) * fraction);
+    std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+    return samples[index];
+}
+
+// Frame đầu tiên chứa kết quả của một lần nhấn phím có ô trắng ở góc phải, để có thể đo
+// phần còn lại (tới lúc màn hình thật sự sáng) bằng camera tốc độ cao hoặc cảm biến quang
+void Game::renderLatency(const RenderState& state) {
+    if (state.lastPressCounter != 0 && state.lastPressCounter != lastShownPress) {
+        SDL_FRect flash = {(float)SCREEN_WIDTH - 40, (float)SCREEN_HEIGHT - 40, 40, 40};
+        spriteBatch->draw(atlas->getTexture(), atlas->getWhiteRegion(), flash, {255, 255, 255, 255});
+    }
+
+    char line[64];
+    std::snprintf(line, sizeof(line), "input->present p50 %5.1f p99 %5.1f ms",
+                  latencyPercentile(latencySamples, 0.5f), latencyPercentile(latencySamples, 0.99f));
+    textRenderer->draw(line, 6, SCREEN_HEIGHT - 20, {0, 0, 0, 255}, 0.5f);
+}
+
+// Gọi sau khi SDL_RenderPresent trả về; với VSync đó là lúc frame bắt đầu được quét ra màn hình
+void Game::recordLatency(const RenderState& state) {
+    if (state.lastPressCounter == 0 || state.lastPressCounter == lastShownPress) return;
+    lastShownPress = state.lastPressCounter;
+    if (isOnMenu || state.gameOver) return;
+
+    const size_t window = 240;
+    double counts = (double)(SDL_GetPerformanceCounter() - state.lastPressCounter);
+    float milliseconds = (float)(counts * 1000.0 / SDL_GetPerformanceFrequency());
+    if (latencySamples.size() < window) latencySamples.push_back(milliseconds);
+    else latencySamples[latencyCount % window] = milliseconds;
+    latencyCount++;
+}
+
+void Game::printLatencySummary() const {
+    std::cout << "Input to present latency over the last " << latencySamples.size() << " of "
+              << latencyCount << " presses: p50 " << latencyPercentile(latencySamples, 0.5f)
+              << " ms, p99 " << latencyPercentile(latencySamples, 0.99f) << " ms, max "
+              << latencyPercentile(latencySamples, 1.0f) << " ms" << std::endl;
+
+    // Tiếng nằm thêm khoảng một bộ đệm trong thiết bị sau lần trộn đầu tiên có nó
+    std::vector<float> playDelays = sounds->stopMeasuring();
+    float mixDelay = latencyPercentile(playDelays, 0.5f);
+    std::cout << "Audio: " << audioBufferSamples << "-sample buffer (" << sounds->getBufferMs()
+              << " ms), mixed every " << sounds->getMixIntervalMs() << " ms; play to mix over "
+              << playDelays.size() << " sounds: p50 " << mixDelay << " ms, p99 "
+              << latencyPercentile(playDelays, 0.99f) << " ms; estimated play to output p50 "
+              << mixDelay + sounds->getBufferMs() << " ms" << std::endl;
+}
@@ -5,51 +5,163 @@
 #include <SDL_image.h>
 #include <SDL_mixer.h>
 #include <SDL_ttf.h>
-#include "player.h"
-#include "platform.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "world.h"
+#include "text.h"
+#include "batch.h"
+#include "atlas.h"
+#include "assets.h"
+#include "loader.h"
+#include "sound.h"
+#include "profiler.h"
+#include "replay.h"
+#include "streamer.h"
+#include "input.h"
+#include "pacer.h"
+#include "renderstate.h"
+#include "scores.h"
+#include "triplebuffer.h"
 
+enum Sprite {
+    SPRITE_MENU,
+    SPRITE_BACKGROUND,
+    SPRITE_PLAYER_LEFT,
+    SPRITE_PLAYER_RIGHT,
+    SPRITE_PLATFORM,
+    SPRITE_MOVING_PLATFORM,
+    SPRITE_BREAKABLE_PLATFORM,
+    SPRITE_COUNT
+};
+
+enum Sound {
+    SOUND_JUMP,
+    SOUND_FALL,
+    SOUND_COUNT
+};
+
+// Mô phỏng chạy trên luồng riêng với nhịp tick cố định; luồng chính chỉ xử lý sự kiện SDL và vẽ.
+// Hai luồng trao đổi qua renderBuffer (trạng thái để vẽ) và vài biến atomic (phím, lệnh của người chơi),
+// nên VSync hay driver đồ hoạ bị khựng cũng không làm trễ tick.
 class Game {
 private:
     SDL_Window* window;
     SDL_Renderer* renderer;
-    bool isRunning;
+    std::atomic<bool> isRunning;
 
-    Player* player;
-    PlatformManager* platformManager;
-    Mix_Chunk* jumpSound;
+    World* world;
+    ChunkStreamer* chunkStreamer;
+    SoundManager* sounds;
+    int audioBufferSamples;
     TTF_Font* font;
+    TextRenderer* textRenderer;
+    AssetSource* assets;
+    std::string assetPath;
+    AssetLoader* assetLoader;
 
-    SDL_Texture* menuTexture;
-    SDL_Texture* backgroundTexture;
-    SDL_Texture* playerLeftTexture;
-    SDL_Texture* playerRightTexture;
-    SDL_Texture* platformTexture;
-    SDL_Texture* movingPlatformTexture;
-    SDL_Texture* breakablePlatformTexture;
+    TextureAtlas* atlas;
+    SpriteBatch* spriteBatch;
 
-    int score;
     int bestScore;
-    int cameraThreshold;
-
-    void handleEvents();
-    void update();
-    void render();
-    void loadTextures();
-    void loadSounds();
-    bool isOnMenu;
-    void displayText(const std::string& text, int x, int y, SDL_Color color = {0, 0, 0, 0});
+    ScoreBoard* scoreBoard;
+    uint32_t runTicks;
+    uint64_t seed;
+    double startHeight;
+
+    Profiler* profiler;
+    Profiler* simProfiler;
+    std::atomic<bool> showProfiler;
+    std::string tracePath;
+
+    Replay* replay;
+    std::string recordPath;
+    // Thôi ghi khi trạng thái bị thay bằng restore(), vì input đã ghi không còn dẫn tới trạng thái đó
+    bool isRecording;
+    bool isPlayback;
+    float playbackSpeed;
+    bool pendingMute;
+
+    std::thread simThread;
+    mutable std::mutex worldMutex;
+    TripleBuffer<RenderState>* renderBuffer;
+    Uint64 countsPerTick;
+    // Luồng chính ghi, luồng mô phỏng đọc
+    InputTimeline* inputTimeline;
+    std::atomic<int> muteRequests;
+    std::atomic<bool> retryRequested;
+
+    // Luồng mô phỏng ngủ ở đây khi đang ở menu hay màn hình thua
+    std::mutex simWakeMutex;
+    std::condition_variable simWake;
+    bool publishedGameOver;
+
+    FramePacer* framePacer;
+    FramePacer* simPacer;
+    double frameRateLimit;
+    // Menu và màn hình thua chỉ vẽ lại khi có sự kiện hoặc nội dung đổi
+    uint64_t shownScreenKey;
+
+    // Chế độ đo độ trễ từ lúc nhấn phím tới lúc frame đầu tiên có kết quả được đưa lên màn hình
+    bool latencyMode;
+    uint64_t lastShownPress;
+    std::vector<float> latencySamples;
+    size_t latencyCount;
+
+    bool handleEvents(Uint32 waitMs = 0);
+    bool handleEvent(const SDL_Event& e);
+    void wakeSimulation();
+    uint64_t staticScreenKey(const RenderState& state, Uint32 nowMs) const;
+    void pushKeyEvent(const SDL_KeyboardEvent& key);
+    void update(Uint64 tickEnd);
+    void simulationLoop();
+    void publishRenderState(uint64_t tickCounter);
+    void render(const RenderState& state, float alpha);
+    void renderPlatforms(const RenderState& state, float alpha);
+    void renderPlayer(const RenderState& state, float alpha);
+    void renderGameOver(const RenderState& state);
+    bool drawSprite(int sprite, const SDL_FRect& dest);
+    void drawBackground(int sprite);
+    void requestAssets();
+    void receiveAsset(LoadedAsset& asset);
+    void receiveAssets();
+    std::atomic<bool> isOnMenu;
+    void displayText(const std::string& text, int x, int y, SDL_Color color = {0, 0, 0, 255});
+    void displayCachedText(const std::string& text, int x, int y, SDL_Color color = {0, 0, 0, 255});
     bool isMuted;
-    void saveBestScore();
-    void loadBestScore();
+    void saveRun();
     bool isGameOver;
-    void handleGameOverScreen();
+    void renderProfiler(const RenderState& state);
+    void renderLatency(const RenderState& state);
+    void recordLatency(const RenderState& state);
+    void printLatencySummary() const;
+    void toggleMute();
+    void runUncapped();
+    void finishPlayback();
 
 public:
-    Game();
+    Game(uint64_t seed);
     ~Game();
 
     bool init();
     void run();
+    // Gói tài nguyên tạo bằng blt_pack; không có thì đọc file rời trong images/, sound/, font/
+    void setAssetPath(const std::string& path);
+    void setTracePath(const std::string& path);
+    void setRecordPath(const std::string& path);
+    bool loadReplay(const std::string& path, float speed);
+    void setStartHeight(double height);
+    void setLatencyMode(bool enabled);
+    // Giới hạn số frame vẽ mỗi giây; âm là tự chọn theo màn hình, 0 là không giới hạn
+    void setFrameRateLimit(double limit);
+    // Số mẫu mỗi bộ đệm âm thanh; nhỏ thì tiếng tới tai sớm hơn nhưng dễ rè trên máy yếu
+    void setAudioBufferSize(int samples);
+
+    bool snapshot(WorldSnapshot& out) const;
+    // Không dùng được khi đang phát lại. Lượt đang ghi sẽ bị bỏ, và trạng thái khôi phục không tính vào điểm cao.
+    bool restore(const WorldSnapshot& in);
 };
 
 #endif // GAME_H_INCLUDED
@@ -86,13 +86,5 @@ void renderTexture(SDL_Texture *texture, int x, int y, SDL_Renderer* renderer)
 	SDL_RenderCopy(renderer, texture, NULL, &dest);
 }
 
-bool initAudio() {
-    if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) < 0) {
-        std::cout << "SDL_mixer could not initialize! SDL_mixer Error: " << Mix_GetError() << std::endl;
-        return false;
-    }
-    return true;
-}
-
 
 #endif // GRAPHICS_H_INCLUDE
@@ -0,0 +1,67 @@
+#include "input.h"
+#include <algorithm>
+
+InputTimeline::InputTimeline() {
+    readCount = 0;
+    writeCount = 0;
+    lastPressTime = 0;
+    std::fill(keyDown, keyDown + INPUT_KEY_COUNT, false);
+}
+
+bool InputTimeline::push(const KeyEvent& event) {
+    uint32_t written = writeCount.load(std::memory_order_relaxed);
+    uint32_t read = readCount.load(std::memory_order_acquire);
+    if (written - read >= QUEUE_SIZE) return false;
+
+    queue[written % QUEUE_SIZE] = event;
+    writeCount.store(written + 1, std::memory_order_release);
+    return true;
+}
+
+InputState InputTimeline::sample(uint64_t tickStart, uint64_t tickEnd) {
+    uint64_t held[INPUT_KEY_COUNT] = {0, 0};
+    uint64_t downSince[INPUT_KEY_COUNT] = {tickStart, tickStart};
+    bool touched[INPUT_KEY_COUNT];
+    for (int k = 0; k < INPUT_KEY_COUNT; k++) {
+        touched[k] = keyDown[k];
+    }
+
+    uint32_t read = readCount.load(std::memory_order_relaxed);
+    uint32_t written = writeCount.load(std::memory_order_acquire);
+    for (; read != written; read++) {
+        const KeyEvent& event = queue[read % QUEUE_SIZE];
+        // Sự kiện của tick sau thì để lại
+        if (event.time >= tickEnd) break;
+        if (event.key >= INPUT_KEY_COUNT) continue;
+
+        int k = event.key;
+        uint64_t time = std::max(event.time, tickStart);
+        if (event.down && !keyDown[k]) {
+            keyDown[k] = true;
+            touched[k] = true;
+            downSince[k] = time;
+            lastPressTime = event.time;
+        } else if (!event.down && keyDown[k]) {
+            keyDown[k] = false;
+            held[k] += time - downSince[k];
+        }
+    }
+    readCount.store(read, std::memory_order_release);
+
+    uint64_t length = std::max<uint64_t>(tickEnd - tickStart, 1);
+    uint8_t steps[INPUT_KEY_COUNT];
+    for (int k = 0; k < INPUT_KEY_COUNT; k++) {
+        if (keyDown[k]) held[k] += tickEnd - downSince[k];
+
+        // Đã chạm phím trong tick thì được ít nhất một nấc, để cú bấm rất ngắn không bị mất
+        uint64_t rounded = (held[k] * INPUT_HOLD_STEPS + length / 2) / length;
+        steps[k] = touched[k] ? (uint8_t)std::min<uint64_t>(std::max<uint64_t>(rounded, 1), INPUT_HOLD_STEPS) : 0;
+    }
+
+    InputState input;
+    input.left = steps[INPUT_KEY_LEFT] > 0;
+    input.right = steps[INPUT_KEY_RIGHT] > 0;
+    input.leftHold = input.left ? steps[INPUT_KEY_LEFT] : INPUT_HOLD_STEPS;
+    input.rightHold = input.right ? steps[INPUT_KEY_RIGHT] : INPUT_HOLD_STEPS;
+    return input;
+}
@@ -0,0 +1,53 @@
+#ifndef INPUT_H_INCLUDED
+#define INPUT_H_INCLUDED
+#include <atomic>
+#include <cstdint>
+#include "world.h"
+
+enum InputKey : uint8_t {
+    INPUT_KEY_LEFT,
+    INPUT_KEY_RIGHT,
+    INPUT_KEY_COUNT
+};
+
+// time tính theo cùng đồng hồ với các mốc tick (bộ đếm hiệu năng của SDL trong game)
+struct KeyEvent {
+    uint64_t time;
+    uint8_t key;
+    uint8_t down;
+};
+
+// Sự kiện nhấn/nhả phím có mốc thời gian, đi từ luồng xử lý sự kiện sang luồng mô phỏng
+// qua hàng đợi vòng một-ghi-một-đọc không khoá. Mỗi tick lấy đúng các sự kiện rơi vào
+// khoảng thời gian của nó và đổi ra phần tick mà mỗi phím được giữ, nên cú bấm nhanh
+// giữa hai frame vẫn có tác dụng.
+class InputTimeline {
+private:
+    static constexpr uint32_t QUEUE_SIZE = 256;
+
+    KeyEvent queue[QUEUE_SIZE];
+    std::atomic<uint32_t> readCount;
+    std::atomic<uint32_t> writeCount;
+
+    // Chỉ luồng mô phỏng dùng
+    bool keyDown[INPUT_KEY_COUNT];
+    uint64_t lastPressTime;
+
+public:
+    InputTimeline();
+
+    InputTimeline(const InputTimeline&) = delete;
+    InputTimeline& operator=(const InputTimeline&) = delete;
+
+    // Luồng sự kiện gọi; trả về false (bỏ sự kiện) nếu hàng đợi đầy
+    bool push(const KeyEvent& event);
+
+    // Luồng mô phỏng gọi ngay trước tick phủ khoảng [tickStart, tickEnd).
+    // Sự kiện tới trễ (mốc trước tickStart) được tính như xảy ra đầu tick.
+    InputState sample(uint64_t tickStart, uint64_t tickEnd);
+
+    // Mốc thời gian của lần nhấn phím gần nhất đã được tick nào đó dùng, 0 nếu chưa có
+    uint64_t getLastPressTime() const { return lastPressTime; }
+};
+
+#endif // INPUT_H_INCLUDED
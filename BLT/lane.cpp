@@ -0,0 +1,304 @@
+#include "lane.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define LANE_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+// ---- Kernel vô hướng (dùng khi không có SIMD và để xử lý phần đuôi) ----
+
+static void advanceMovingScalar(float* x, float* direction, size_t n, float speed, float width, float screenWidth) {
+    const float limit = screenWidth - width;
+
+    for (size_t i = 0; i < n; i++) {
+        x[i] += direction[i] * speed;
+
+        if (x[i] <= 0) {
+            direction[i] = 1.0f;
+        }
+        else if (x[i] >= limit) {
+            direction[i] = -1.0f;
+        }
+    }
+}
+
+static void tickBreakTimersScalar(int* breakTimer, int* broken, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        if (breakTimer[i] > 0) {
+            breakTimer[i]--;
+            if (breakTimer[i] == 0) broken[i] = 1;
+        }
+    }
+}
+
+#ifdef LANE_X86_SIMD
+
+// ---- SSE2: 4 platform mỗi vòng ----
+
+__attribute__((target("sse2")))
+static void advanceMovingSSE2(float* x, float* direction, size_t n, float speed, float width, float screenWidth) {
+    const __m128 vSpeed = _mm_set1_ps(speed);
+    const __m128 vZero = _mm_setzero_ps();
+    const __m128 vLimit = _mm_set1_ps(screenWidth - width);
+    const __m128 vOne = _mm_set1_ps(1.0f);
+    const __m128 vMinusOne = _mm_set1_ps(-1.0f);
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 px = _mm_loadu_ps(x + i);
+        __m128 dir = _mm_loadu_ps(direction + i);
+        px = _mm_add_ps(px, _mm_mul_ps(dir, vSpeed));
+
+        __m128 hitLeft = _mm_cmple_ps(px, vZero);
+        __m128 hitRight = _mm_andnot_ps(hitLeft, _mm_cmpge_ps(px, vLimit));
+        dir = _mm_or_ps(_mm_andnot_ps(hitLeft, dir), _mm_and_ps(hitLeft, vOne));
+        dir = _mm_or_ps(_mm_andnot_ps(hitRight, dir), _mm_and_ps(hitRight, vMinusOne));
+
+        _mm_storeu_ps(x + i, px);
+        _mm_storeu_ps(direction + i, dir);
+    }
+    advanceMovingScalar(x + i, direction + i, n - i, speed, width, screenWidth);
+}
+
+__attribute__((target("sse2")))
+static void tickBreakTimersSSE2(int* breakTimer, int* broken, size_t n) {
+    const __m128i vZero = _mm_setzero_si128();
+    const __m128i vOne = _mm_set1_epi32(1);
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i timer = _mm_loadu_si128((const __m128i*)(breakTimer + i));
+        __m128i state = _mm_loadu_si128((const __m128i*)(broken + i));
+
+        __m128i active = _mm_cmpgt_epi32(timer, vZero);
+        timer = _mm_sub_epi32(timer, _mm_and_si128(active, vOne));
+        __m128i expired = _mm_and_si128(active, _mm_cmpeq_epi32(timer, vZero));
+        state = _mm_or_si128(state, _mm_and_si128(expired, vOne));
+
+        _mm_storeu_si128((__m128i*)(breakTimer + i), timer);
+        _mm_storeu_si128((__m128i*)(broken + i), state);
+    }
+    tickBreakTimersScalar(breakTimer + i, broken + i, n - i);
+}
+
+// ---- AVX2: 8 platform mỗi vòng ----
+
+__attribute__((target("avx2")))
+static void advanceMovingAVX2(float* x, float* direction, size_t n, float speed, float width, float screenWidth) {
+    const __m256 vSpeed = _mm256_set1_ps(speed);
+    const __m256 vZero = _mm256_setzero_ps();
+    const __m256 vLimit = _mm256_set1_ps(screenWidth - width);
+    const __m256 vOne = _mm256_set1_ps(1.0f);
+    const __m256 vMinusOne = _mm256_set1_ps(-1.0f);
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 px = _mm256_loadu_ps(x + i);
+        __m256 dir = _mm256_loadu_ps(direction + i);
+        px = _mm256_add_ps(px, _mm256_mul_ps(dir, vSpeed));
+
+        __m256 hitLeft = _mm256_cmp_ps(px, vZero, _CMP_LE_OQ);
+        __m256 hitRight = _mm256_andnot_ps(hitLeft, _mm256_cmp_ps(px, vLimit, _CMP_GE_OQ));
+        dir = _mm256_blendv_ps(dir, vOne, hitLeft);
+        dir = _mm256_blendv_ps(dir, vMinusOne, hitRight);
+
+        _mm256_storeu_ps(x + i, px);
+        _mm256_storeu_ps(direction + i, dir);
+    }
+    advanceMovingScalar(x + i, direction + i, n - i, speed, width, screenWidth);
+}
+
+__attribute__((target("avx2")))
+static void tickBreakTimersAVX2(int* breakTimer, int* broken, size_t n) {
+    const __m256i vZero = _mm256_setzero_si256();
+    const __m256i vOne = _mm256_set1_epi32(1);
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i timer = _mm256_loadu_si256((const __m256i*)(breakTimer + i));
+        __m256i state = _mm256_loadu_si256((const __m256i*)(broken + i));
+
+        __m256i active = _mm256_cmpgt_epi32(timer, vZero);
+        timer = _mm256_sub_epi32(timer, _mm256_and_si256(active, vOne));
+        __m256i expired = _mm256_and_si256(active, _mm256_cmpeq_epi32(timer, vZero));
+        state = _mm256_or_si256(state, _mm256_and_si256(expired, vOne));
+
+        _mm256_storeu_si256((__m256i*)(breakTimer + i), timer);
+        _mm256_storeu_si256((__m256i*)(broken + i), state);
+    }
+    tickBreakTimersScalar(breakTimer + i, broken + i, n - i);
+}
+
+#endif // LANE_X86_SIMD
+
+// ---- Chọn kernel một lần theo CPU đang chạy ----
+
+typedef void (*AdvanceMovingKernel)(float*, float*, size_t, float, float, float);
+typedef void (*TickBreakTimersKernel)(int*, int*, size_t);
+
+struct LaneKernels {
+    AdvanceMovingKernel advanceMoving;
+    TickBreakTimersKernel tickBreakTimers;
+};
+
+static LaneKernels selectKernels() {
+    LaneKernels kernels = {advanceMovingScalar, tickBreakTimersScalar};
+
+#ifdef LANE_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        kernels = {advanceMovingAVX2, tickBreakTimersAVX2};
+    }
+    else if (__builtin_cpu_supports("sse2")) {
+        kernels = {advanceMovingSSE2, tickBreakTimersSSE2};
+    }
+#endif
+
+    return kernels;
+}
+
+static const LaneKernels& kernels() {
+    static const LaneKernels selected = selectKernels();
+    return selected;
+}
+
+// ---- PlatformLane ----
+
+PlatformLane::PlatformLane() {
+    head = 0;
+    count = 0;
+}
+
+void PlatformLane::reserve(size_t capacity) {
+    x.assign(capacity, 0.0f);
+    y.assign(capacity, 0.0);
+    prevX.assign(capacity, 0.0f);
+    prevY.assign(capacity, 0.0);
+    direction.assign(capacity, 1.0f);
+    breakTimer.assign(capacity, 0);
+    broken.assign(capacity, 0);
+    head = 0;
+    count = 0;
+}
+
+void PlatformLane::clear() {
+    head = 0;
+    count = 0;
+}
+
+bool PlatformLane::push(float newX, double newY) {
+    if (full()) return false;
+
+    size_t s = slot(count);
+    x[s] = newX;
+    y[s] = newY;
+    prevX[s] = newX;
+    prevY[s] = newY;
+    direction[s] = 1.0f;
+    breakTimer[s] = 0;
+    broken[s] = 0;
+    count++;
+    return true;
+}
+
+void PlatformLane::popFront() {
+    if (count == 0) return;
+
+    head++;
+    if (head == x.size()) head = 0;
+    count--;
+}
+
+void PlatformLane::startBreaking(size_t index, int ticks) {
+    size_t s = slot(index);
+    if (!broken[s]) {
+        breakTimer[s] = ticks;
+    }
+}
+
+PlatformRange PlatformLane::queryRange(double minY, double maxY) const {
+    PlatformRange range;
+
+    size_t low = 0;
+    size_t high = count;
+    while (low < high) {
+        size_t mid = (low + high) / 2;
+        if (getY(mid) > maxY) low = mid + 1;
+        else high = mid;
+    }
+    range.first = low;
+
+    high = count;
+    while (low < high) {
+        size_t mid = (low + high) / 2;
+        if (getY(mid) >= minY) low = mid + 1;
+        else high = mid;
+    }
+    range.last = low;
+
+    return range;
+}
+
+// Các kernel chạy trên đoạn liên tục trong bộ nhớ: vùng sống của hàng đợi vòng
+// gồm tối đa hai đoạn [head, cuối mảng) và [0, phần quấn lại).
+void PlatformLane::savePreviousState() {
+    size_t firstSpan = std::min(count, x.size() - head);
+    size_t secondSpan = count - firstSpan;
+
+    std::memcpy(prevX.data() + head, x.data() + head, firstSpan * sizeof(float));
+    std::memcpy(prevY.data() + head, y.data() + head, firstSpan * sizeof(double));
+    std::memcpy(prevX.data(), x.data(), secondSpan * sizeof(float));
+    std::memcpy(prevY.data(), y.data(), secondSpan * sizeof(double));
+}
+
+void PlatformLane::advanceMoving(float speed, float width, float screenWidth) {
+    size_t firstSpan = std::min(count, x.size() - head);
+    size_t secondSpan = count - firstSpan;
+
+    kernels().advanceMoving(x.data() + head, direction.data() + head, firstSpan, speed, width, screenWidth);
+    kernels().advanceMoving(x.data(), direction.data(), secondSpan, speed, width, screenWidth);
+}
+
+void PlatformLane::tickBreakTimers() {
+    size_t firstSpan = std::min(count, x.size() - head);
+    size_t secondSpan = count - firstSpan;
+
+    kernels().tickBreakTimers(breakTimer.data() + head, broken.data() + head, firstSpan);
+    kernels().tickBreakTimers(breakTimer.data(), broken.data(), secondSpan);
+}
+
+bool PlatformLane::saveState(LaneSnapshot& out) const {
+    if (count > LANE_SNAPSHOT_CAPACITY) return false;
+
+    out.count = (uint32_t)count;
+    for (size_t i = 0; i < count; i++) {
+        size_t s = slot(i);
+        out.x[i] = x[s];
+        out.y[i] = y[s];
+        out.prevX[i] = prevX[s];
+        out.prevY[i] = prevY[s];
+        out.direction[i] = direction[s];
+        out.breakTimer[i] = breakTimer[s];
+        out.broken[i] = broken[s];
+    }
+    return true;
+}
+
+// Khôi phục với head = 0, nên thứ tự trong bộ nhớ có thể khác lúc chụp nhưng thứ tự logic giữ nguyên
+bool PlatformLane::restoreState(const LaneSnapshot& in) {
+    if (in.count > x.size() || in.count > LANE_SNAPSHOT_CAPACITY) return false;
+
+    size_t n = in.count;
+    std::memcpy(x.data(), in.x, n * sizeof(float));
+    std::memcpy(y.data(), in.y, n * sizeof(double));
+    std::memcpy(prevX.data(), in.prevX, n * sizeof(float));
+    std::memcpy(prevY.data(), in.prevY, n * sizeof(double));
+    std::memcpy(direction.data(), in.direction, n * sizeof(float));
+    std::memcpy(breakTimer.data(), in.breakTimer, n * sizeof(int));
+    std::memcpy(broken.data(), in.broken, n * sizeof(int));
+    head = 0;
+    count = n;
+    return true;
+}
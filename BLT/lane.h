@@ -0,0 +1,79 @@
+#ifndef LANE_H_INCLUDED
+#define LANE_H_INCLUDED
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+struct PlatformRange {
+    size_t first;
+    size_t last;
+};
+
+// Sức chứa cố định của ảnh chụp. Lane thực tế cần platformLaneCapacity(SCREEN_HEIGHT) chỗ
+// (36 với màn hình cao 800); platform.h kiểm tra điều này lúc biên dịch
+const size_t LANE_SNAPSHOT_CAPACITY = 48;
+
+// Bản sao phẳng của một lane, chép được bằng memcpy. Platform xếp theo chỉ số logic.
+struct LaneSnapshot {
+    uint32_t count;
+    float x[LANE_SNAPSHOT_CAPACITY];
+    double y[LANE_SNAPSHOT_CAPACITY];
+    float prevX[LANE_SNAPSHOT_CAPACITY];
+    double prevY[LANE_SNAPSHOT_CAPACITY];
+    float direction[LANE_SNAPSHOT_CAPACITY];
+    int32_t breakTimer[LANE_SNAPSHOT_CAPACITY];
+    int32_t broken[LANE_SNAPSHOT_CAPACITY];
+};
+
+// Hàng đợi vòng dạng structure-of-arrays cho các platform cùng một loại.
+// y là toạ độ thế giới (double, không bị dịch khi camera cuộn).
+// Chỉ số logic 0 là platform thấp nhất (y lớn nhất); y giảm dần theo chỉ số.
+class PlatformLane {
+private:
+    std::vector<float> x;
+    std::vector<double> y;
+    std::vector<float> prevX;
+    std::vector<double> prevY;
+    std::vector<float> direction;
+    std::vector<int> breakTimer;
+    std::vector<int> broken;
+    size_t head;
+    size_t count;
+
+    size_t slot(size_t index) const {
+        size_t s = head + index;
+        return s >= x.size() ? s - x.size() : s;
+    }
+
+public:
+    PlatformLane();
+
+    void reserve(size_t capacity);
+    void clear();
+    bool push(float newX, double newY);
+    void popFront();
+
+    size_t size() const { return count; }
+    size_t capacity() const { return x.size(); }
+    bool empty() const { return count == 0; }
+    bool full() const { return count == x.size(); }
+
+    float getX(size_t index) const { return x[slot(index)]; }
+    double getY(size_t index) const { return y[slot(index)]; }
+    float getPrevX(size_t index) const { return prevX[slot(index)]; }
+    double getPrevY(size_t index) const { return prevY[slot(index)]; }
+    float getDirection(size_t index) const { return direction[slot(index)]; }
+    bool isBroken(size_t index) const { return broken[slot(index)] != 0; }
+    void startBreaking(size_t index, int ticks);
+
+    PlatformRange queryRange(double minY, double maxY) const;
+
+    bool saveState(LaneSnapshot& out) const;
+    bool restoreState(const LaneSnapshot& in);
+
+    void savePreviousState();
+    void advanceMoving(float speed, float width, float screenWidth);
+    void tickBreakTimers();
+};
+
+#endif // LANE_H_INCLUDED
@@ -0,0 +1,117 @@
+#include "loader.h"
+#include <SDL_image.h>
+#include <algorithm>
+
+AssetLoader::AssetLoader(const AssetSource& assets, int threadCount) : assets(assets) {
+    outstanding = 0;
+    stopping = false;
+
+    if (threadCount <= 0) {
+        threadCount = std::min(MAX_THREADS, std::max(1, (int)std::thread::hardware_concurrency()));
+    }
+    for (int i = 0; i < threadCount; i++) {
+        workers.emplace_back(&AssetLoader::workerLoop, this);
+    }
+}
+
+AssetLoader::~AssetLoader() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    requestAdded.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    // Những gì đã giải mã mà chưa ai nhận
+    for (LoadedAsset& result : results) {
+        if (result.surface) SDL_FreeSurface(result.surface);
+        if (result.sound) Mix_FreeChunk(result.sound);
+    }
+}
+
+void AssetLoader::request(AssetKind kind, int id, const std::string& name) {
+    LoadedAsset asset;
+    asset.kind = kind;
+    asset.id = id;
+    asset.name = name;
+    asset.surface = nullptr;
+    asset.sound = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        requests.push_back(asset);
+        outstanding++;
+    }
+    requestAdded.notify_one();
+}
+
+void AssetLoader::requestImage(int id, const std::string& name) {
+    request(ASSET_IMAGE, id, name);
+}
+
+void AssetLoader::requestSound(int id, const std::string& name) {
+    request(ASSET_SOUND, id, name);
+}
+
+void AssetLoader::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        requestAdded.wait(lock, [this] { return stopping || !requests.empty(); });
+        if (stopping) return;
+
+        LoadedAsset asset = requests.front();
+        requests.pop_front();
+        lock.unlock();
+
+        if (asset.kind == ASSET_IMAGE) {
+            SDL_Surface* loaded = IMG_Load_RW(assets.open(asset.name), 1);
+            if (loaded) {
+                asset.surface = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_RGBA32, 0);
+                SDL_FreeSurface(loaded);
+            } else {
+                SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_ERROR, "Load texture %s: %s", asset.name.c_str(), IMG_GetError());
+            }
+        } else {
+            asset.sound = Mix_LoadWAV_RW(assets.open(asset.name), 1);
+            if (!asset.sound) {
+                SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_ERROR, "Load sound %s: %s", asset.name.c_str(), Mix_GetError());
+            }
+        }
+
+        lock.lock();
+        results.push_back(asset);
+        resultAdded.notify_all();
+
+        SDL_Event wake;
+        SDL_zero(wake);
+        wake.type = SDL_USEREVENT;
+        SDL_PushEvent(&wake);
+    }
+}
+
+bool AssetLoader::poll(LoadedAsset& out) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (results.empty()) return false;
+
+    out = results.front();
+    results.pop_front();
+    outstanding--;
+    return true;
+}
+
+bool AssetLoader::wait(LoadedAsset& out) {
+    std::unique_lock<std::mutex> lock(mutex);
+    resultAdded.wait(lock, [this] { return !results.empty() || outstanding == 0; });
+    if (results.empty()) return false;
+
+    out = results.front();
+    results.pop_front();
+    outstanding--;
+    return true;
+}
+
+bool AssetLoader::isDone() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return outstanding == 0;
+}
@@ -0,0 +1,70 @@
+#ifndef LOADER_H_INCLUDED
+#define LOADER_H_INCLUDED
+#include <SDL.h>
+#include <SDL_mixer.h>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "assets.h"
+
+enum AssetKind {
+    ASSET_IMAGE,
+    ASSET_SOUND
+};
+
+// Kết quả giải mã một file. Ảnh đã đổi sẵn sang SDL_PIXELFORMAT_RGBA32, âm thanh đã ra PCM.
+// Giải mã lỗi thì surface/sound là nullptr. Người nhận giữ quyền giải phóng.
+struct LoadedAsset {
+    AssetKind kind;
+    int id;
+    std::string name;
+    SDL_Surface* surface;
+    Mix_Chunk* sound;
+};
+
+// Giải mã ảnh và âm thanh song song trên vài luồng nền để luồng chính hiện được frame đầu sớm.
+// Yêu cầu được làm theo thứ tự gửi, nên thứ gì cần trước (ảnh menu) thì gửi trước.
+// Mỗi khi có kết quả, một SDL_USEREVENT được gửi để đánh thức luồng chính nếu nó đang ngủ chờ sự kiện.
+// Chỉ phần tạo texture (cần renderer) là phải làm trên luồng chính.
+// Không dùng ThreadPool vì parallelFor bắt luồng gọi chờ tới khi xong, còn ở đây luồng chính phải
+// vẽ menu trong lúc ảnh đang giải mã.
+class AssetLoader {
+private:
+    const AssetSource& assets;
+
+    std::vector<std::thread> workers;
+    mutable std::mutex mutex;
+    std::condition_variable requestAdded;
+    std::condition_variable resultAdded;
+    std::deque<LoadedAsset> requests;
+    std::deque<LoadedAsset> results;
+    // Đã yêu cầu mà luồng chính chưa nhận
+    size_t outstanding;
+    bool stopping;
+
+    void request(AssetKind kind, int id, const std::string& name);
+    void workerLoop();
+
+public:
+    // threadCount <= 0 thì lấy theo số nhân, tối đa MAX_THREADS
+    static constexpr int MAX_THREADS = 4;
+    explicit AssetLoader(const AssetSource& assets, int threadCount = 0);
+    ~AssetLoader();
+
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+
+    void requestImage(int id, const std::string& name);
+    void requestSound(int id, const std::string& name);
+
+    // Lấy một kết quả nếu có, không chờ
+    bool poll(LoadedAsset& out);
+    // Chờ tới khi có kết quả; false nếu không còn gì đang giải mã
+    bool wait(LoadedAsset& out);
+    bool isDone() const;
+};
+
+#endif // LOADER_H_INCLUDED
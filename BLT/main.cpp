@@ -1,10 +1,76 @@
 #include <SDL.h>
 #include <SDL_image.h>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
 #include "def.h"
 #include "game.h"
 
 int main(int argc, char* argv[]) {
-    Game game;
+    std::random_device rd;
+    uint64_t seed = ((uint64_t)rd() << 32) | rd();
+    std::string tracePath;
+    std::string assetPath;
+    std::string recordPath;
+    std::string replayPath;
+    float replaySpeed = 1.0f;
+    double startHeight = 0.0;
+    bool latencyMode = false;
+    double frameRateLimit = -1.0;
+    int audioBufferSamples = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = std::strtoull(argv[++i], NULL, 10);
+        }
+        else if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            tracePath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--assets") == 0 && i + 1 < argc) {
+            assetPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            recordPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replayPath = argv[++i];
+        }
+        // Chế độ luyện tập: bắt đầu thẳng ở độ cao cho trước
+        else if (std::strcmp(argv[i], "--start-height") == 0 && i + 1 < argc) {
+            startHeight = std::atof(argv[++i]);
+        }
+        // Giới hạn số frame mỗi giây; 0 là không giới hạn, mặc định theo VSync hoặc tần số quét màn hình
+        else if (std::strcmp(argv[i], "--fps") == 0 && i + 1 < argc) {
+            frameRateLimit = std::atof(argv[++i]);
+        }
+        // Số mẫu mỗi bộ đệm âm thanh (mặc định 512, khoảng 12 ms); tăng lên nếu tiếng bị rè
+        else if (std::strcmp(argv[i], "--audio-buffer") == 0 && i + 1 < argc) {
+            audioBufferSamples = std::atoi(argv[++i]);
+        }
+        // In độ trễ từ lúc nhấn phím tới lúc frame được đưa lên màn hình
+        else if (std::strcmp(argv[i], "--latency") == 0) {
+            latencyMode = true;
+        }
+        // --speed 0 chạy replay nhanh nhất có thể và bỏ qua phần vẽ
+        else if (std::strcmp(argv[i], "--speed") == 0 && i + 1 < argc) {
+            replaySpeed = (float)std::atof(argv[++i]);
+        }
+    }
+    std::cout << "Seed: " << seed << std::endl;
+
+    Game game(seed);
+    game.setTracePath(tracePath);
+    if (!assetPath.empty()) game.setAssetPath(assetPath);
+    game.setStartHeight(startHeight);
+    game.setLatencyMode(latencyMode);
+    game.setFrameRateLimit(frameRateLimit);
+    if (audioBufferSamples > 0) game.setAudioBufferSize(audioBufferSamples);
+    if (!recordPath.empty()) game.setRecordPath(recordPath);
+    if (!replayPath.empty() && !game.loadReplay(replayPath, replaySpeed)) {
+        return 1;
+    }
 
     if (!game.init()) {
         return 1;
@@ -0,0 +1,66 @@
+#include "pacer.h"
+#include <algorithm>
+#include <thread>
+
+// Giới hạn của phần quay vòng cuối mỗi lần chờ
+static const std::chrono::microseconds MIN_SPIN_MARGIN(250);
+static const std::chrono::microseconds MAX_SPIN_MARGIN(4000);
+
+FramePacer::FramePacer(double targetRate) {
+    spinMargin = std::chrono::microseconds(1000);
+    nextFrame = Clock::now();
+    setTargetRate(targetRate);
+}
+
+void FramePacer::setTargetRate(double targetRate) {
+    if (targetRate > 0.0) {
+        frameDuration = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / targetRate));
+    } else {
+        frameDuration = Clock::duration::zero();
+    }
+    nextFrame = Clock::now() + frameDuration;
+}
+
+double FramePacer::getTargetRate() const {
+    if (frameDuration == Clock::duration::zero()) return 0.0;
+    return 1.0 / std::chrono::duration<double>(frameDuration).count();
+}
+
+void FramePacer::waitForNextFrame() {
+    if (frameDuration == Clock::duration::zero()) return;
+
+    Clock::time_point now = Clock::now();
+    if (now - nextFrame > frameDuration) {
+        nextFrame = now + frameDuration;
+        return;
+    }
+
+    waitUntil(nextFrame);
+    nextFrame += frameDuration;
+}
+
+void FramePacer::waitUntil(Clock::time_point deadline) {
+    Clock::time_point sleepUntil = deadline - spinMargin;
+    Clock::time_point now = Clock::now();
+
+    if (now < sleepUntil) {
+        std::this_thread::sleep_until(sleepUntil);
+
+        // Ngủ quá giờ bao nhiêu thì lần sau chừa phần quay vòng chừng đó (cộng chút dư),
+        // còn nếu dậy đúng giờ thì thu hẹp dần phần quay vòng
+        Clock::duration oversleep = Clock::now() - sleepUntil;
+        Clock::duration wanted = oversleep + MIN_SPIN_MARGIN;
+        if (wanted > spinMargin) spinMargin = wanted;
+        else spinMargin -= (spinMargin - wanted) / 16;
+        spinMargin = std::min<Clock::duration>(std::max<Clock::duration>(spinMargin, MIN_SPIN_MARGIN), MAX_SPIN_MARGIN);
+    }
+
+    while (Clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+}
+
+void FramePacer::waitFor(double seconds) {
+    if (seconds <= 0.0) return;
+    waitUntil(Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds)));
+}
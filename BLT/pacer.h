@@ -0,0 +1,30 @@
+#ifndef PACER_H_INCLUDED
+#define PACER_H_INCLUDED
+#include <chrono>
+
+// Giữ nhịp frame mà không chiếm trọn một nhân: ngủ bằng hệ điều hành tới gần hạn rồi mới quay vòng
+// (có nhường CPU) phần cuối cho đúng giờ. Phần quay vòng tự co giãn theo độ ngủ quá giờ đo được,
+// nên trên máy có bộ hẹn giờ chính xác gần như không phải quay vòng.
+class FramePacer {
+public:
+    typedef std::chrono::steady_clock Clock;
+
+private:
+    Clock::duration frameDuration;
+    Clock::time_point nextFrame;
+    Clock::duration spinMargin;
+
+public:
+    // targetRate <= 0 nghĩa là không giới hạn (chỉ dựa vào VSync nếu có)
+    explicit FramePacer(double targetRate = 0.0);
+
+    void setTargetRate(double targetRate);
+    double getTargetRate() const;
+
+    // Chờ tới lượt frame tiếp theo; nếu đã trễ hơn một frame thì bắt nhịp lại từ bây giờ
+    void waitForNextFrame();
+    void waitUntil(Clock::time_point deadline);
+    void waitFor(double seconds);
+};
+
+#endif // PACER_H_INCLUDED
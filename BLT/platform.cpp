@@ -1,273 +1,228 @@
 #include "platform.h"
 #include "def.h"
+#include "streamer.h"
 #include <algorithm>
+#include <cstdlib>
+#include <iostream>
 
-Platform::Platform(int x, int y, int width, int height, PlatformType platformType) {
-    rect.x = x;
-    rect.y = y;
-    rect.w = width;
-    rect.h = height;
-    type = platformType;
-    speed = 3.5f;
-    direction = 1;
-    screenWidth = SCREEN_WIDTH;
-    texture = nullptr;
-    broken = false;
-    breakTimer = 0;
-}
-
-Platform::~Platform() {}
-
-void Platform::render(SDL_Renderer* renderer) {
-
-    if (broken) return;
-
-    if (texture) {
-        SDL_RenderCopy(renderer, texture, NULL, &rect);
-    }
-
-    else {
-        SDL_SetRenderDrawColor(renderer, 100, 100, 255, 255);
-        SDL_RenderFillRect(renderer, &rect);
-    }
-}
-
-void Platform::update() {
-    if (type == PlatformType::MOVING) {
-        rect.x += direction * speed;
-
-        if (rect.x <= 0) {
-
-            direction = 1;
-
-        }
-
-        else if (rect.x + rect.w >= screenWidth) {
-
-            direction = -1;
-
-        }
-    }
-
-    if (type == PlatformType::BREAKABLE && breakTimer > 0) {
+bool hasIntersection(const Rect& a, const Rect& b) {
+    if (a.w <= 0 || a.h <= 0 || b.w <= 0 || b.h <= 0) return false;
 
-        breakTimer--;
-
-        if (breakTimer == 0) {
-            broken = true;
-        }
-    }
-}
-
-void Platform::startBreaking() {
-    if (type == PlatformType::BREAKABLE && !broken) {
-        breakTimer = 15;
-    }
+    return a.x < b.x + b.w && b.x < a.x + a.w &&
+           a.y < b.y + b.h && b.y < a.y + a.h;
 }
 
-PlatformManager::PlatformManager(int screenWidth, int screenHeight) {
+PlatformManager::PlatformManager(int screenWidth, int screenHeight, uint64_t seed) {
     this->screenWidth = screenWidth;
     this->screenHeight = screenHeight;
     platformWidth = PLATFORM_WIDTH;
     platformHeight = PLATFORM_HEIGHT;
+    movingSpeed = 3.5f;
+    breakTicks = 15;
 
-    std::random_device rd;
-    rng = std::mt19937(rd());
-    xDist = std::uniform_int_distribution<int>(0, screenWidth - platformWidth);
-    typeDist = std::uniform_int_distribution<int>(0, 10);
-
-    platformTexture = nullptr;
-    movingPlatformTexture = nullptr;
-    breakablePlatformTexture = nullptr;
+    this->seed = seed;
+    rng.seed(seed);
+    life = 0;
 
     difficultyLevel = 0;
-    platformsPerLevel = 5;
-    basePlatformCount = 15;
+    levelSeed = 0;
+    nextChunk = 0;
+    streamer = nullptr;
+
+    generationLookahead = PLATFORM_GENERATION_LOOKAHEAD;
+    size_t capacity = platformLaneCapacity(screenHeight);
+    for (auto& lane : lanes) {
+        lane.reserve(capacity);
+    }
 }
 
 PlatformManager::~PlatformManager() {}
 
 void PlatformManager::initialize(int numPlatforms) {
-    platforms.clear();
+    for (auto& lane : lanes) {
+        lane.clear();
+    }
 
     int startX = 50;
     int startY = 60;
-
-    platforms.push_back(Platform(startX, startY, platformWidth, platformHeight, PlatformType::NORMAL));
-
-    if (platformTexture) {
-        platforms.back().setTexture(platformTexture);
-    }
+    bool startPlaced = false;
+    int dropped = 0;
 
     for (int i = 1; i < numPlatforms; i++) {
         int y = screenHeight - (i * (screenHeight / numPlatforms));
-        int x = xDist(rng);
+        int x = rng.range(0, screenWidth - platformWidth);
 
-        int randValue = typeDist(rng);
+        int randValue = rng.range(0, 10);
         PlatformType platformType;
 
         switch (randValue) {
-        case 1:
-            platformType = PlatformType::NORMAL;
-            break;
         case 0:
             platformType = PlatformType::MOVING;
             break;
         case 2:
             platformType = PlatformType::BREAKABLE;
             break;
-    }
-        platforms.push_back(Platform(x, y, platformWidth, platformHeight, platformType));
-
-        if (platformType == PlatformType::MOVING && movingPlatformTexture) {
-            platforms.back().setTexture(movingPlatformTexture);
-        }
-
-        else if (platformType == PlatformType::BREAKABLE && breakablePlatformTexture) {
-            platforms.back().setTexture(breakablePlatformTexture);
+        default:
+            platformType = PlatformType::NORMAL;
+            break;
         }
-
-        else if (platformTexture) {
-            platforms.back().setTexture(platformTexture);
+        if (!startPlaced && y < startY) {
+            dropped += !pushPlatform(startX, startY, PlatformType::NORMAL);
+            startPlaced = true;
         }
 
-        platforms.back().setScreenWidth(screenWidth);
+        dropped += !pushPlatform(x, y, platformType);
     }
-}
 
-void PlatformManager::render(SDL_Renderer* renderer) {
-    for (auto& platform : platforms) {
-        platform.render(renderer);
+    if (!startPlaced) {
+        dropped += !pushPlatform(startX, startY, PlatformType::NORMAL);
     }
-}
-
-void PlatformManager::update() {
-    for (auto& platform : platforms) {
-        platform.update();
+    // Lane đầy nghĩa là sức chứa tính trong constructor sai; màn chơi có thể không leo được nữa
+    if (dropped > 0) {
+        std::cerr << "Platform lanes are full, dropped " << dropped << " platforms of the first screen" << std::endl;
     }
 
-    platforms.erase(
-        std::remove_if(platforms.begin(), platforms.end(),
-            [](const Platform& p) {
-                return p.isBroken();
-            }),
-        platforms.end()
-    );
+    // Mỗi lượt chơi một levelSeed mới, nên chơi lại vẫn gặp màn khác
+    levelSeed = levelSeedFor(seed, life++);
+    nextChunk = 0;
+    difficultyLevel = 0;
+    if (streamer) streamer->request(levelSeed, nextChunk);
+    streamChunks(0.0);
 }
 
-void PlatformManager::scrollPlatforms(float scrollAmount) {
-    for (auto& platform : platforms) {
-        platform.setY(platform.getRect().y + scrollAmount);
+// Bắt đầu thẳng ở độ cao bất kỳ (chế độ luyện tập): chỉ sinh các chunk từ đáy màn hình trở lên
+void PlatformManager::initializeAt(double cameraY) {
+    for (auto& lane : lanes) {
+        lane.clear();
     }
-}
 
-void PlatformManager::removeBottomPlatforms() {
-    platforms.erase(
-        std::remove_if(platforms.begin(), platforms.end(),
-            [this](const Platform& p) {
-                return p.getRect().y > screenHeight;
-            }),
-        platforms.end()
-    );
+    levelSeed = levelSeedFor(seed, life++);
+    nextChunk = chunkIndexAt(cameraY + screenHeight);
+    updateDifficulty(-cameraY);
+    if (streamer) streamer->request(levelSeed, nextChunk);
+    streamChunks(cameraY);
 }
 
-void PlatformManager::updateDifficulty(int score) {
-    int newLevel = score / 1000;
-
-    if (newLevel != difficultyLevel) {
-        difficultyLevel = newLevel;
+bool PlatformManager::pushPlatform(int x, double y, PlatformType platformType) {
+    return getLane(platformType).push((float)x, y);
+}
 
-        platformsPerLevel = std::max(2, 5 - (difficultyLevel / 2));
+size_t PlatformManager::getPlatformCount() const {
+    size_t total = 0;
+    for (const auto& lane : lanes) {
+        total += lane.size();
     }
+    return total;
 }
 
-int PlatformManager::getPlatformsToGenerate() const {
-    return platformsPerLevel;
+float PlatformManager::getVelocityX(PlatformType type, size_t index) const {
+    if (type != PlatformType::MOVING) return 0.0f;
+    return getLane(type).getDirection(index) * movingSpeed;
 }
 
-void PlatformManager::addNewPlatforms(int numToAdd) {
-    if (platforms.empty()) return;
+void PlatformManager::startBreaking(size_t index) {
+    getLane(PlatformType::BREAKABLE).startBreaking(index, breakTicks);
+}
 
-    int highestY = screenHeight;
-    for (const auto& platform : platforms) {
-        if (platform.getRect().y < highestY) {
-            highestY = platform.getRect().y;
-        }
+void PlatformManager::savePreviousState() {
+    for (auto& lane : lanes) {
+        lane.savePreviousState();
     }
+}
 
-    int verticalGap = MAX_JUMP_HEIGHT * 0.75 * (1.0f + (difficultyLevel * 0.1f));
-    int currentY = highestY;
-
-    for (int i = 0; i < numToAdd; i++) {
-        currentY -= verticalGap;
-
-        int newX = xDist(rng);
-
-        PlatformType platformType = PlatformType::NORMAL;
-
-        if (i > 0) {
-            int randVal = rand() % 100;
-
-            int movingChance = 15 + (difficultyLevel * 3);
-            int breakableChance = 10 + (difficultyLevel * 10);
+void PlatformManager::update() {
+    getLane(PlatformType::MOVING).advanceMoving(movingSpeed, (float)platformWidth, (float)screenWidth);
+    getLane(PlatformType::BREAKABLE).tickBreakTimers();
+}
 
-            movingChance = std::min(movingChance, 30);
-            breakableChance = std::min(breakableChance, 40);
+void PlatformManager::removeBottomPlatforms(double cameraY) {
+    double bottom = cameraY + screenHeight;
 
-            if (randVal < breakableChance) {
-                platformType = PlatformType::BREAKABLE;
-            } else if (randVal < breakableChance + movingChance) {
-                platformType = PlatformType::MOVING;
-            }
+    for (auto& lane : lanes) {
+        while (!lane.empty() && lane.getY(0) > bottom) {
+            lane.popFront();
         }
+    }
+}
 
-        platforms.push_back(Platform(newX, currentY, platformWidth, platformHeight, platformType));
+void PlatformManager::updateDifficulty(double height) {
+    difficultyLevel = difficultyAtHeight(height);
+}
 
-        if (platformType == PlatformType::MOVING && movingPlatformTexture) {
-            platforms.back().setTexture(movingPlatformTexture);
-        }
+void PlatformManager::setChunkStreamer(ChunkStreamer* newStreamer) {
+    streamer = newStreamer;
+    if (streamer) streamer->request(levelSeed, nextChunk);
+}
 
-        else if (platformType == PlatformType::BREAKABLE && breakablePlatformTexture) {
-            platforms.back().setTexture(breakablePlatformTexture);
-        }
+// Nạp thêm chunk khi phần đã sinh sắp lộ ra dưới mép trên màn hình. Chunk thường đã được
+// luồng nền sinh sẵn; nếu chưa thì sinh luôn ở đây và báo luồng nền đuổi theo.
+void PlatformManager::streamChunks(double cameraY) {
+    double generationTop = cameraY - generationLookahead;
 
-        else if (platformTexture) {
-            platforms.back().setTexture(platformTexture);
+    while (-(double)nextChunk * CHUNK_HEIGHT > generationTop) {
+        LevelChunk chunk;
+        if (!streamer || !streamer->take(levelSeed, nextChunk, chunk)) {
+            generateChunk(levelSeed, nextChunk, screenWidth, platformWidth, chunk);
+            if (streamer) streamer->request(levelSeed, nextChunk + 1);
         }
+        appendChunk(chunk);
+        nextChunk++;
+    }
+}
 
-        platforms.back().setScreenWidth(screenWidth);
+void PlatformManager::appendChunk(const LevelChunk& chunk) {
+    int dropped = 0;
+    for (int i = 0; i < chunk.count; i++) {
+        dropped += !pushPlatform((int)chunk.x[i], chunk.y[i], (PlatformType)chunk.type[i]);
+    }
+    if (dropped > 0) {
+        std::cerr << "Platform lanes are full, dropped " << dropped << " platforms of chunk " << chunk.index << std::endl;
     }
 }
 
 bool PlatformManager::isOverlapping(int x, int y) const {
-    for (const auto& platform : platforms) {
-        SDL_Rect rect = platform.getRect();
-        int dx = std::abs(rect.x - x);
-        int dy = std::abs(rect.y - y);
+    for (const auto& lane : lanes) {
+        PlatformRange range = lane.queryRange((float)(y - MIN_Y_GAP + 1), (float)(y + MIN_Y_GAP - 1));
 
-        if (dx < platformWidth - MIN_X_GAP && dy < MIN_Y_GAP) {
-            return true;
+        for (size_t i = range.first; i < range.last; i++) {
+            int dx = std::abs((int)lane.getX(i) - x);
+            int dy = std::abs((int)lane.getY(i) - y);
+
+            if (dx < platformWidth - MIN_X_GAP && dy < MIN_Y_GAP) {
+                return true;
+            }
         }
     }
     return false;
 }
 
-void PlatformManager::setTextures(SDL_Texture* normalTexture, SDL_Texture* movingTexture, SDL_Texture* breakableTexture) {
-    platformTexture = normalTexture;
-    movingPlatformTexture = movingTexture ? movingTexture : normalTexture;
-    breakablePlatformTexture = breakableTexture ? breakableTexture : normalTexture;
-
-    for (auto& platform : platforms) {
-        if (platform.getType() == PlatformType::MOVING && movingPlatformTexture) {
-            platform.setTexture(movingPlatformTexture);
-        }
-
-        else if (platform.getType() == PlatformType::BREAKABLE && breakablePlatformTexture) {
-            platform.setTexture(breakablePlatformTexture);
-        }
+bool PlatformManager::saveState(PlatformManagerSnapshot& out) const {
+    for (int i = 0; i < PLATFORM_TYPE_COUNT; i++) {
+        if (!lanes[i].saveState(out.lanes[i])) return false;
+    }
+    out.rng = rng;
+    out.difficultyLevel = difficultyLevel;
+    out.levelSeed = levelSeed;
+    out.nextChunk = nextChunk;
+    out.life = life;
+    out.seed = seed;
+    return true;
+}
 
-        else {
-            platform.setTexture(platformTexture);
-        }
-    }
+bool PlatformManager::restoreState(const PlatformManagerSnapshot& in) {
+    for (int i = 0; i < PLATFORM_TYPE_COUNT; i++) {
+        if (in.lanes[i].count > lanes[i].capacity()) return false;
+    }
+    for (int i = 0; i < PLATFORM_TYPE_COUNT; i++) {
+        lanes[i].restoreState(in.lanes[i]);
+    }
+    rng = in.rng;
+    difficultyLevel = in.difficultyLevel;
+    levelSeed = in.levelSeed;
+    nextChunk = in.nextChunk;
+    life = in.life;
+    // Ảnh chụp có thể lấy từ một World khác seed; levelSeedFor của lượt sau phải dùng seed đó
+    seed = in.seed;
+    if (streamer) streamer->request(levelSeed, nextChunk);
+    return true;
 }
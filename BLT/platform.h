@@ -1,8 +1,20 @@
 #ifndef PLATFORM_H_INCLUDED
 #define PLATFORM_H_INCLUDED
-#include <SDL.h>
-#include <vector>
-#include <random>
+#include <cstddef>
+#include <cstdint>
+#include "chunk.h"
+#include "def.h"
+#include "lane.h"
+#include "rng.h"
+
+class ChunkStreamer;
+
+struct Rect {
+    int x, y;
+    int w, h;
+};
+
+bool hasIntersection(const Rect& a, const Rect& b);
 
 enum class PlatformType {
     NORMAL,
@@ -10,73 +22,91 @@ enum class PlatformType {
     BREAKABLE
 };
 
-class Platform {
-private:
-    SDL_Rect rect;
-    PlatformType type;
-    float speed;
-    int direction;
-    int screenWidth;
-    SDL_Texture* texture;
-    bool broken;
-    int breakTimer;
+const int PLATFORM_TYPE_COUNT = 3;
 
-public:
-    Platform(int x, int y, int width, int height, PlatformType platformType = PlatformType::NORMAL);
-    ~Platform();
+// Chunk được nạp khi mép trên của phần đã sinh chưa cao hơn camera chừng này pixel
+const int PLATFORM_GENERATION_LOOKAHEAD = CHUNK_HEIGHT / 4;
 
-    void render(SDL_Renderer* renderer);
-    void update();
-    void startBreaking();
+// Số platform tối đa cùng lúc trong vùng sống: vùng này cao tối đa một màn hình + lookahead + một chunk,
+// mỗi hàng chỉ có một platform, khoảng cách dọc nhỏ nhất là ở độ khó 0 (màn đầu dùng screenHeight / 15);
+// cộng thêm vài chỗ cho platform xuất phát và platform vừa trôi qua đáy.
+// Đây là giới hạn cho cả tổng mọi lane lẫn từng lane (khi mọi platform cùng một loại).
+constexpr size_t platformLaneCapacity(int screenHeight) {
+    return (size_t)((screenHeight + PLATFORM_GENERATION_LOOKAHEAD + CHUNK_HEIGHT)
+                    / std::min(chunkRowSpacing(0), (double)screenHeight / 15)) + 4;
+}
 
-    SDL_Rect getRect() const { return rect; }
-    PlatformType getType() const { return type; }
-    bool isMoving() const { return type == PlatformType::MOVING; }
-    bool isBreakable() const { return type == PlatformType::BREAKABLE; }
-    bool isBroken() const { return broken; }
+static_assert(platformLaneCapacity(SCREEN_HEIGHT) <= LANE_SNAPSHOT_CAPACITY,
+              "LANE_SNAPSHOT_CAPACITY is too small for a full lane at SCREEN_HEIGHT");
 
-    void setScreenWidth(int width) { screenWidth = width; }
-    void setTexture(SDL_Texture* newTexture) { texture = newTexture; }
-    void setY(int newY) { rect.y = newY; }
+struct PlatformManagerSnapshot {
+    LaneSnapshot lanes[PLATFORM_TYPE_COUNT];
+    Rng rng;
+    int32_t difficultyLevel;
+    uint64_t levelSeed;
+    int32_t nextChunk;
+    int32_t life;
+    uint64_t seed;
 };
 
+// Mỗi loại platform nằm trong một PlatformLane riêng, nên các vòng cập nhật chỉ chạy trên
+// dữ liệu đồng nhất. Trong mỗi lane, platform được sắp theo y giảm dần: phần tử đầu là
+// platform thấp nhất. Platform vỡ vẫn giữ chỗ cho tới khi trôi khỏi đáy màn hình.
+// Mọi toạ độ y là toạ độ thế giới; cameraY là y thế giới của mép trên màn hình.
+// Màn hình đầu tiên do initialize() sinh; phía trên y = 0 là các chunk (xem chunk.h).
 class PlatformManager {
 private:
-    std::vector<Platform> platforms;
+    PlatformLane lanes[PLATFORM_TYPE_COUNT];
     int screenWidth;
     int screenHeight;
     int platformWidth;
     int platformHeight;
-    std::mt19937 rng;
-    std::uniform_int_distribution<int> xDist;
-    std::uniform_int_distribution<int> typeDist;
-    SDL_Texture* platformTexture;
-    SDL_Texture* movingPlatformTexture;
-    SDL_Texture* breakablePlatformTexture;
+    float movingSpeed;
+    int breakTicks;
+    Rng rng;
     int difficultyLevel;
-    int platformsPerLevel;
-    int basePlatformCount;
+    int generationLookahead;
+
+    // Phần trên màn hình đầu được sinh theo chunk; lượt chơi thứ life dùng levelSeedFor(seed, life)
+    uint64_t seed;
+    int life;
+    uint64_t levelSeed;
+    int nextChunk;
+    ChunkStreamer* streamer;
+
+    bool pushPlatform(int x, double y, PlatformType platformType);
+    void appendChunk(const LevelChunk& chunk);
 
 public:
-    PlatformManager(int screenWidth, int screenHeight);
+    PlatformManager(int screenWidth, int screenHeight, uint64_t seed);
     ~PlatformManager();
 
     void initialize(int numPlatforms);
-    void render(SDL_Renderer* renderer);
+    void initializeAt(double cameraY);
     void update();
+    void savePreviousState();
 
-    void scrollPlatforms(float scrollAmount);
-    void removeBottomPlatforms();
-    void addNewPlatforms(int numToAdd);
-
-    void setTextures(SDL_Texture* normalTexture, SDL_Texture* movingTexture = nullptr, SDL_Texture* breakableTexture = nullptr);
+    void removeBottomPlatforms(double cameraY);
+    void streamChunks(double cameraY);
+    void setChunkStreamer(ChunkStreamer* newStreamer);
 
-    const std::vector<Platform>& getPlatforms() const { return platforms; }
-    std::vector<Platform>& getPlatforms() { return platforms; }
+    const PlatformLane& getLane(PlatformType type) const { return lanes[(int)type]; }
+    PlatformLane& getLane(PlatformType type) { return lanes[(int)type]; }
+    size_t getPlatformCount() const;
+    int getPlatformWidth() const { return platformWidth; }
+    int getPlatformHeight() const { return platformHeight; }
+    float getVelocityX(PlatformType type, size_t index) const;
+    void startBreaking(size_t index);
     bool isOverlapping(int x, int y) const;
 
-    void updateDifficulty(int score);
-    int getPlatformsToGenerate() const;
+    void updateDifficulty(double height);
+    int getDifficultyLevel() const { return difficultyLevel; }
+    uint64_t getLevelSeed() const { return levelSeed; }
+    float getMovingSpeed() const { return movingSpeed; }
+    int getBreakTicks() const { return breakTicks; }
+
+    bool saveState(PlatformManagerSnapshot& out) const;
+    bool restoreState(const PlatformManagerSnapshot& in);
 };
 
 #endif // PLATFORM_H_INCLUDED
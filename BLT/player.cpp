@@ -1,10 +1,13 @@
 #include "player.h"
 #include "def.h"
 #include <algorithm>
+#include <cmath>
 
 Player::Player(int startX, int startY, int size) {
     x = startX;
     y = startY;
+    prevX = startX;
+    prevY = startY;
     width = size;
     height = size;
     stepX = 6.5f;
@@ -12,115 +15,164 @@ Player::Player(int startX, int startY, int size) {
     velocityY = 0.0f;
     gravity = 0.3f;
     jumpStrength = -9.0f;
-    texture = nullptr;
-    facingLeft = false;
-    jumpSound = nullptr;
-    isFallingSoundPlaying = false;
-    previousVelocityY = 0.0f;
+    facingLeft = true;
 }
 
 Player::~Player() {}
 
-void Player::render(SDL_Renderer* renderer) {
-    if (texture) {
-        SDL_Rect destRect = {x, y - height, width, height};
-        SDL_RenderCopy(renderer, texture, NULL, &destRect);
-    }
+void Player::savePreviousState() {
+    prevX = x;
+    prevY = y;
 }
 
-void Player::update(std::vector<Platform>& platforms) {
+void Player::update(PlatformManager& platformManager) {
 
     if (isJumping) {
         velocityY += gravity;
-        float remainingMovement = velocityY;
-        int steps = std::max(1, int(std::abs(remainingMovement)));
-        float dy = remainingMovement / steps;
-
-        for (int i = 0; i < steps; ++i) {
-            y += dy;
-            for (auto& platform : platforms) {
-                if (checkPlatformCollision(platform)) {
-                    break;
+        double fromY = y;
+        double toY = y + velocityY;
+
+        if (velocityY < 0) {
+            y = toY;
+            return;
+        }
+
+        // Quét bàn chân từ fromY tới toY một lần, lấy platform chạm sớm nhất
+        const int footHeight = 5;
+        double sweepTop = std::floor(fromY) - footHeight - platformManager.getPlatformHeight();
+        double sweepBottom = std::ceil(toY);
+
+        bool hasContact = false;
+        PlatformType contactType = PlatformType::NORMAL;
+        size_t contactIndex = 0;
+        float contactTime = 2.0f;
+
+        for (int t = 0; t < PLATFORM_TYPE_COUNT; t++) {
+            PlatformType type = (PlatformType)t;
+            PlatformRange range = platformManager.getLane(type).queryRange(sweepTop, sweepBottom);
+
+            for (size_t i = range.first; i < range.last; ++i) {
+                float time = findContactTime(platformManager, type, i, fromY, toY);
+                if (time >= 0.0f && time < contactTime) {
+                    contactTime = time;
+                    contactType = type;
+                    contactIndex = i;
+                    hasContact = true;
                 }
             }
-            if (!isJumping) break;
         }
-    }
-}
 
-void Player::setJumpSound (Mix_Chunk* sound) {
-    jumpSound = sound;
+        if (!hasContact) {
+            y = toY;
+            return;
+        }
+
+        y = platformManager.getLane(contactType).getY(contactIndex);
+        velocityY = 0;
+        isJumping = false;
+
+        if (contactType == PlatformType::BREAKABLE) {
+            platformManager.startBreaking(contactIndex);
+        }
+    }
 }
 
 void Player::jump() {
     if (!isJumping) {
         isJumping = true;
         velocityY = jumpStrength;
-
-        if(jumpSound) {
-            Mix_PlayChannel(-1, jumpSound, 0);
-        }
     }
 }
 
-void Player::moveRight() {
-    x += stepX;
+void Player::moveRight(float amount) {
+    x += stepX * amount;
     facingLeft = false;
 
     if (x > SCREEN_WIDTH) {
         x = -width;
+        prevX = x;
     }
 }
 
-void Player::moveLeft() {
-    x -= stepX;
+void Player::moveLeft(float amount) {
+    x -= stepX * amount;
     facingLeft = true;
 
     if (x < -width) {
         x = SCREEN_WIDTH;
+        prevX = x;
     }
 }
 
-bool Player::checkPlatformCollision(Platform& platform) {
-    if (velocityY < 0) return false;
-
-    if (platform.isBroken()) return false;
+// Trả về thời điểm t trong [0, 1] của tick mà bàn chân chạm mặt trên platform, hoặc -1 nếu không chạm.
+// Bàn chân đè lên platform khi platform.y < y < platform.y + h + footHeight và hai đoạn x giao nhau.
+float Player::findContactTime(const PlatformManager& platformManager, PlatformType type, size_t index,
+                              double fromY, double toY) const {
+    const PlatformLane& lane = platformManager.getLane(type);
+    if (lane.isBroken(index)) return -1.0f;
 
     const int footHeight = 5;
-    SDL_Rect footRect = {
-        x,
-        y - footHeight,
-        width,
-        footHeight
-    };
-
-    SDL_Rect platformRect = platform.getRect();
-
-    if (SDL_HasIntersection(&footRect, &platformRect)) {
-        y = platformRect.y;
-        velocityY = 0;
-        isJumping = false;
+    float platformX = lane.getX(index);
+    double platformY = lane.getY(index);
+    float platformWidth = (float)platformManager.getPlatformWidth();
+    float platformHeight = (float)platformManager.getPlatformHeight();
+    double travelY = toY - fromY;
+
+    float enter = 0.0f;
+    float exit = 1.0f;
+
+    if (travelY > 0.0) {
+        enter = std::max(enter, (float)((platformY - fromY) / travelY));
+        exit = std::min(exit, (float)((platformY + platformHeight + footHeight - fromY) / travelY));
+    }
+    else if (fromY <= platformY || fromY >= platformY + platformHeight + footHeight) {
+        return -1.0f;
+    }
 
-        if (platform.isBreakable()) {
-            platform.startBreaking();
-        }
+    // Platform di chuyển thì đoạn x của nó trượt theo vận tốc trong cùng tick
+    float velocityX = platformManager.getVelocityX(type, index);
+    float gapLeft = x - (platformX + platformWidth);
+    float gapRight = x + width - platformX;
 
-        return true;
+    if (velocityX == 0.0f) {
+        if (gapLeft >= 0.0f || gapRight <= 0.0f) return -1.0f;
+    }
+    else {
+        float t0 = gapLeft / velocityX;
+        float t1 = gapRight / velocityX;
+        if (t0 > t1) std::swap(t0, t1);
+        enter = std::max(enter, t0);
+        exit = std::min(exit, t1);
     }
 
-    return false;
+    if (enter >= exit) return -1.0f;
+    return enter;
 }
 
-void Player::setTexture(SDL_Texture* newTexture) {
-    texture = newTexture;
+void Player::setPosition(float newX, double newY) {
+    prevX += newX - x;
+    prevY += newY - y;
+    x = newX;
+    y = newY;
 }
 
-void Player::setTextures(SDL_Texture* leftTexture, SDL_Texture* rightTexture) {
-    texture = facingLeft ? leftTexture : rightTexture;
-}
 
-void Player::setPosition(int newX, int newY) {
-    x = newX;
-    y = newY;
+void Player::saveState(PlayerState& out) const {
+    out.x = x;
+    out.prevX = prevX;
+    out.y = y;
+    out.prevY = prevY;
+    out.velocityY = velocityY;
+    out.isJumping = isJumping;
+    out.facingLeft = facingLeft;
 }
 
+void Player::restoreState(const PlayerState& in) {
+    x = in.x;
+    prevX = in.prevX;
+    y = in.y;
+    prevY = in.prevY;
+    velocityY = in.velocityY;
+    isJumping = in.isJumping != 0;
+    facingLeft = in.facingLeft != 0;
+}
@@ -1,49 +1,58 @@
 #ifndef PLAYER_H_INCLUDED
 #define PLAYER_H_INCLUDED
-#include <SDL.h>
-#include <SDL_mixer.h>
-#include <vector>
 #include "platform.h"
 
+struct PlayerState {
+    float x, prevX;
+    double y, prevY;
+    float velocityY;
+    uint8_t isJumping;
+    uint8_t facingLeft;
+};
+
 class Player {
 private:
-    int x, y;
+    float x, prevX;
+    double y, prevY;
     int width, height;
     float stepX;
     bool isJumping;
     float velocityY;
     float gravity;
     float jumpStrength;
-    SDL_Texture* texture;
     bool facingLeft;
-    Mix_Chunk* jumpSound;
-    bool isFallingSoundPlaying;
-    float previousVelocityY;
 
 public:
     Player(int startX, int startY, int size);
     ~Player();
 
-    void render(SDL_Renderer* renderer);
-    void update(std::vector<Platform>& platforms);
+    void update(PlatformManager& platformManager);
+    void savePreviousState();
     void jump();
-    void moveRight();
-    void moveLeft();
-    bool checkPlatformCollision(Platform& platform);
-
-    void setTexture(SDL_Texture* texture);
-    void setTextures(SDL_Texture* leftTexture, SDL_Texture* rightTexture);
-
-    int getX() const { return x; }
-    int getY() const { return y; }
+    // amount là phần tick mà phím được giữ, 1 là đi trọn stepX
+    void moveRight(float amount = 1.0f);
+    void moveLeft(float amount = 1.0f);
+    float findContactTime(const PlatformManager& platformManager, PlatformType type, size_t index,
+                          double fromY, double toY) const;
+
+    float getX() const { return x; }
+    double getY() const { return y; }
+    float getPrevX() const { return prevX; }
+    double getPrevY() const { return prevY; }
     int getWidth() const { return width; }
     int getHeight() const { return height; }
     bool getIsJumping() const { return isJumping; }
+    bool isFacingLeft() const { return facingLeft; }
+    float getVelocityY() const { return velocityY; }
+    float getStepX() const { return stepX; }
+    float getGravity() const { return gravity; }
+    float getJumpStrength() const { return jumpStrength; }
 
-    void setPosition(int newX, int newY);
-    void setJumpSound (Mix_Chunk* sound);
-
+    void setPosition(float newX, double newY);
+    void setVelocityY(float newVelocityY) { velocityY = newVelocityY; }
 
+    void saveState(PlayerState& out) const;
+    void restoreState(const PlayerState& in);
 };
 
 #endif // PLAYER_H_INCLUDED
@@ -0,0 +1,132 @@
+#include "profiler.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+Profiler::Profiler() {
+    origin = Clock::now();
+    historyIndex = 0;
+    historyCount = 0;
+    tracing = false;
+    threadId = 1;
+
+    for (int i = 0; i < PHASE_COUNT; i++) {
+        phaseStart[i] = origin;
+        frameTotals[i] = 0.0;
+        std::fill(history[i], history[i] + WINDOW_FRAMES, 0.0f);
+    }
+}
+
+void Profiler::setTracing(bool enabled) {
+    tracing = enabled;
+    if (tracing) trace.reserve(64 * 1024);
+}
+
+double Profiler::toMicroseconds(Clock::time_point time) const {
+    return std::chrono::duration<double, std::micro>(time - origin).count();
+}
+
+void Profiler::beginFrame() {
+    std::fill(frameTotals, frameTotals + PHASE_COUNT, 0.0);
+    begin(PHASE_FRAME);
+}
+
+void Profiler::endFrame() {
+    end(PHASE_FRAME);
+
+    for (int i = 0; i < PHASE_COUNT; i++) {
+        history[i][historyIndex] = (float)(frameTotals[i] / 1000.0);
+    }
+    historyIndex = (historyIndex + 1) % WINDOW_FRAMES;
+    historyCount = std::min(historyCount + 1, WINDOW_FRAMES);
+}
+
+void Profiler::begin(ProfilePhase phase) {
+    phaseStart[phase] = Clock::now();
+}
+
+void Profiler::end(ProfilePhase phase) {
+    Clock::time_point now = Clock::now();
+    double startUs = toMicroseconds(phaseStart[phase]);
+    double durationUs = toMicroseconds(now) - startUs;
+
+    frameTotals[phase] += durationUs;
+
+    if (tracing && trace.size() < MAX_TRACE_EVENTS) {
+        trace.push_back({phase, startUs, durationUs});
+    }
+}
+
+PhaseStats Profiler::getStats(ProfilePhase phase) const {
+    PhaseStats stats = {0.0f, 0.0f, 0.0f};
+    if (historyCount == 0) return stats;
+
+    float sorted[WINDOW_FRAMES];
+    std::copy(history[phase], history[phase] + historyCount, sorted);
+    std::sort(sorted, sorted + historyCount);
+
+    stats.p50 = sorted[(historyCount - 1) / 2];
+    stats.p99 = sorted[(historyCount - 1) * 99 / 100];
+    stats.max = sorted[historyCount - 1];
+    return stats;
+}
+
+const char* Profiler::getPhaseName(ProfilePhase phase) {
+    static const char* const names[PHASE_COUNT] = {
+        "frame",
+        "events",
+        "update",
+        "upd player",
+        "upd platforms",
+        "difficulty",
+        "camera",
+        "render",
+        "background",
+        "draw platforms",
+        "draw player",
+        "text",
+        "present",
+        "save score"
+    };
+    return names[phase];
+}
+
+bool Profiler::writeTrace(const std::string& path, const Profiler* other) const {
+    std::ofstream outFile(path);
+    if (!outFile.is_open()) {
+        std::cerr << "Failed to write trace file " << path << std::endl;
+        return false;
+    }
+
+    static const char* const categories[PHASE_COUNT] = {
+        "frame", "frame", "frame", "update", "update", "update", "update",
+        "frame", "render", "render", "render", "render", "render", "frame"
+    };
+
+    outFile << std::fixed << std::setprecision(3);
+    outFile << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    const Profiler* sources[2] = {this, other};
+    bool first = true;
+    for (const Profiler* source : sources) {
+        if (!source) continue;
+
+        // Đưa mốc thời gian của profiler kia về cùng gốc với profiler này
+        double offsetUs = toMicroseconds(source->origin);
+        for (const TraceEvent& event : source->trace) {
+            outFile << (first ? "" : ",\n")
+                    << "{\"name\":\"" << getPhaseName(event.phase)
+                    << "\",\"cat\":\"" << categories[event.phase]
+                    << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << source->threadId
+                    << ",\"ts\":" << event.startUs + offsetUs
+                    << ",\"dur\":" << event.durationUs << "}";
+            first = false;
+        }
+
+        if (source->trace.size() >= MAX_TRACE_EVENTS) {
+            std::cerr << "Trace buffer was full, later events were dropped" << std::endl;
+        }
+    }
+    outFile << "\n]}\n";
+    return true;
+}
@@ -0,0 +1,93 @@
+#ifndef PROFILER_H_INCLUDED
+#define PROFILER_H_INCLUDED
+#include <chrono>
+#include <string>
+#include <vector>
+
+enum ProfilePhase {
+    PHASE_FRAME,
+    PHASE_EVENTS,
+    PHASE_UPDATE,
+    PHASE_UPDATE_PLAYER,
+    PHASE_UPDATE_PLATFORMS,
+    PHASE_UPDATE_DIFFICULTY,
+    PHASE_UPDATE_CAMERA,
+    PHASE_RENDER,
+    PHASE_RENDER_BACKGROUND,
+    PHASE_RENDER_PLATFORMS,
+    PHASE_RENDER_PLAYER,
+    PHASE_RENDER_TEXT,
+    PHASE_RENDER_PRESENT,
+    PHASE_SAVE_SCORE,
+    PHASE_COUNT
+};
+
+struct PhaseStats {
+    float p50;
+    float p99;
+    float max;
+};
+
+// Đo thời gian từng pha trong mỗi frame. Giữ cửa sổ trượt WINDOW_FRAMES frame gần nhất
+// để tính p50/p99/max, và (nếu bật) ghi lại sự kiện để xuất file trace của Chrome/Perfetto.
+class Profiler {
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    static constexpr int WINDOW_FRAMES = 240;
+    static constexpr size_t MAX_TRACE_EVENTS = 1 << 20;
+
+    struct TraceEvent {
+        ProfilePhase phase;
+        double startUs;
+        double durationUs;
+    };
+
+    Clock::time_point origin;
+    Clock::time_point phaseStart[PHASE_COUNT];
+    double frameTotals[PHASE_COUNT];
+    float history[PHASE_COUNT][WINDOW_FRAMES];
+    int historyIndex;
+    int historyCount;
+
+    bool tracing;
+    int threadId;
+    std::vector<TraceEvent> trace;
+
+    double toMicroseconds(Clock::time_point time) const;
+
+public:
+    Profiler();
+
+    void setTracing(bool enabled);
+    // Mỗi luồng dùng một Profiler riêng; threadId là hàng hiển thị trong file trace
+    void setThreadId(int id) { threadId = id; }
+
+    void beginFrame();
+    void endFrame();
+    void begin(ProfilePhase phase);
+    void end(ProfilePhase phase);
+
+    PhaseStats getStats(ProfilePhase phase) const;
+    static const char* getPhaseName(ProfilePhase phase);
+
+    // other (nếu có) là profiler của luồng khác, được ghi chung vào cùng file trace
+    bool writeTrace(const std::string& path, const Profiler* other = nullptr) const;
+};
+
+// Đo một pha trong phạm vi khối lệnh; không làm gì nếu profiler là nullptr
+class ProfileScope {
+private:
+    Profiler* profiler;
+    ProfilePhase phase;
+
+public:
+    ProfileScope(Profiler* profiler, ProfilePhase phase) : profiler(profiler), phase(phase) {
+        if (profiler) profiler->begin(phase);
+    }
+    ~ProfileScope() {
+        if (profiler) profiler->end(phase);
+    }
+};
+
+#endif // PROFILER_H_INCLUDED
@@ -0,0 +1,46 @@
+#include "renderstate.h"
+#include <algorithm>
+
+void captureRenderState(const World& world, RenderState& out) {
+    const Player& player = world.getPlayer();
+    const PlatformManager& platformManager = world.getPlatformManager();
+    WorldTuning tuning = world.getTuning();
+
+    out.cameraY = world.getCameraY();
+    out.prevCameraY = world.getPrevCameraY();
+
+    out.playerX = player.getX();
+    out.playerPrevX = player.getPrevX();
+    out.playerY = player.getY();
+    out.playerPrevY = player.getPrevY();
+    out.playerWidth = player.getWidth();
+    out.playerHeight = player.getHeight();
+    out.facingLeft = player.isFacingLeft();
+
+    out.platformWidth = platformManager.getPlatformWidth();
+    out.platformHeight = platformManager.getPlatformHeight();
+
+    // Camera có thể nằm ở bất kỳ đâu giữa vị trí tick trước và tick này khi được nội suy
+    double topY = std::min(out.cameraY, out.prevCameraY) - out.platformHeight;
+    double bottomY = std::max(out.cameraY, out.prevCameraY) + tuning.screenHeight;
+
+    out.platformCount = 0;
+    for (int t = 0; t < PLATFORM_TYPE_COUNT; t++) {
+        const PlatformLane& lane = platformManager.getLane((PlatformType)t);
+        PlatformRange range = lane.queryRange(topY, bottomY);
+
+        for (size_t i = range.first; i < range.last && out.platformCount < RENDER_MAX_PLATFORMS; i++) {
+            if (lane.isBroken(i)) continue;
+
+            RenderPlatform& platform = out.platforms[out.platformCount++];
+            platform.x = lane.getX(i);
+            platform.prevX = lane.getPrevX(i);
+            platform.y = lane.getY(i);
+            platform.prevY = lane.getPrevY(i);
+            platform.type = (uint8_t)t;
+        }
+    }
+
+    out.score = world.getScore();
+    out.gameOver = world.isGameOver();
+}
@@ -0,0 +1,49 @@
+#ifndef RENDERSTATE_H_INCLUDED
+#define RENDERSTATE_H_INCLUDED
+#include <cstdint>
+#include "profiler.h"
+#include "world.h"
+
+// Vùng vẽ nằm trong vùng sống của PlatformManager nên số platform thấy được không vượt quá
+// giới hạn tổng của mọi lane; không bao giờ phải cắt bớt
+const int RENDER_MAX_PLATFORMS = (int)platformLaneCapacity(SCREEN_HEIGHT);
+
+struct RenderPlatform {
+    float x, prevX;
+    double y, prevY;
+    uint8_t type;
+};
+
+// Những gì luồng vẽ cần cho một frame, do luồng mô phỏng chụp lại sau mỗi lượt tick.
+// Giữ cả vị trí tick trước lẫn tick hiện tại để luồng vẽ tự nội suy.
+struct RenderState {
+    // Thời điểm (theo bộ đếm hiệu năng) mà tick mới nhất đáng lẽ chạy, để tính hệ số nội suy
+    uint64_t tickCounter;
+
+    double cameraY, prevCameraY;
+
+    float playerX, playerPrevX;
+    double playerY, playerPrevY;
+    int32_t playerWidth, playerHeight;
+    uint8_t facingLeft;
+
+    int32_t platformWidth, platformHeight;
+    int32_t platformCount;
+    RenderPlatform platforms[RENDER_MAX_PLATFORMS];
+
+    int32_t score;
+    int32_t bestScore;
+    uint8_t muted;
+    uint8_t gameOver;
+
+    // Mốc thời gian của lần nhấn phím gần nhất mà mô phỏng đã xử lý, dùng cho chế độ đo độ trễ
+    uint64_t lastPressCounter;
+
+    // Thời gian các pha của luồng mô phỏng, chỉ cập nhật khi bật bảng F3
+    PhaseStats simStats[PHASE_COUNT];
+};
+
+// Chép phần thuộc về World (camera, người chơi, platform đang thấy, điểm) vào out
+void captureRenderState(const World& world, RenderState& out);
+
+#endif // RENDERSTATE_H_INCLUDED
@@ -0,0 +1,172 @@
+#include "replay.h"
+#include "binio.h"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+static const char REPLAY_MAGIC[4] = {'B', 'L', 'T', 'R'};
+
+Replay::Replay() {
+    seed = 0;
+    startHeight = 0.0;
+    std::memset(&tuning, 0, sizeof(tuning));
+    tickCount = 0;
+    playRun = 0;
+    playOffset = 0;
+}
+
+void Replay::startRecording(uint64_t seed, double startHeight, const WorldTuning& tuning) {
+    this->seed = seed;
+    this->startHeight = startHeight;
+    this->tuning = tuning;
+    runs.clear();
+    tickCount = 0;
+    playRun = 0;
+    playOffset = 0;
+}
+
+void Replay::record(uint16_t bits) {
+    if (!runs.empty() && runs.back().bits == bits && runs.back().length < UINT32_MAX) {
+        runs.back().length++;
+    } else {
+        runs.push_back({bits, 1});
+    }
+    tickCount++;
+}
+
+bool Replay::save(const std::string& path) const {
+    std::ofstream outFile(path, std::ios::binary);
+    if (!outFile.is_open()) {
+        std::cerr << "Failed to write replay file " << path << std::endl;
+        return false;
+    }
+
+    outFile.write(REPLAY_MAGIC, sizeof(REPLAY_MAGIC));
+    writeU32(outFile, FORMAT_VERSION);
+    writeU64(outFile, seed);
+    writeDouble(outFile, startHeight);
+
+    writeU32(outFile, (uint32_t)tuning.tickRate);
+    writeU32(outFile, (uint32_t)tuning.screenWidth);
+    writeU32(outFile, (uint32_t)tuning.screenHeight);
+    writeU32(outFile, (uint32_t)tuning.cameraThreshold);
+    writeU32(outFile, (uint32_t)tuning.breakTicks);
+    writeFloat(outFile, tuning.stepX);
+    writeFloat(outFile, tuning.gravity);
+    writeFloat(outFile, tuning.jumpStrength);
+    writeFloat(outFile, tuning.movingSpeed);
+
+    writeU32(outFile, (uint32_t)runs.size());
+    for (const Run& run : runs) {
+        writeVarint(outFile, run.bits);
+        writeVarint(outFile, run.length);
+    }
+
+    return (bool)outFile;
+}
+
+bool Replay::load(const std::string& path) {
+    std::ifstream inFile(path, std::ios::binary);
+    if (!inFile.is_open()) {
+        std::cerr << "Failed to open replay file " << path << std::endl;
+        return false;
+    }
+
+    char magic[4];
+    uint32_t version = 0;
+    if (!inFile.read(magic, sizeof(magic)) || std::memcmp(magic, REPLAY_MAGIC, sizeof(magic)) != 0
+        || !readU32(inFile, version) || version != FORMAT_VERSION) {
+        std::cerr << "Not a supported replay file: " << path << std::endl;
+        return false;
+    }
+
+    WorldTuning loaded;
+    uint32_t runCount = 0;
+    bool ok = readU64(inFile, seed)
+        && readDouble(inFile, startHeight)
+        && readI32(inFile, loaded.tickRate)
+        && readI32(inFile, loaded.screenWidth)
+        && readI32(inFile, loaded.screenHeight)
+        && readI32(inFile, loaded.cameraThreshold)
+        && readI32(inFile, loaded.breakTicks)
+        && readFloat(inFile, loaded.stepX)
+        && readFloat(inFile, loaded.gravity)
+        && readFloat(inFile, loaded.jumpStrength)
+        && readFloat(inFile, loaded.movingSpeed)
+        && readU32(inFile, runCount);
+
+    runs.clear();
+    tickCount = 0;
+    for (uint32_t i = 0; ok && i < runCount; i++) {
+        uint32_t bits = 0;
+        Run run;
+        ok = readVarint(inFile, bits) && bits <= UINT16_MAX
+            && readVarint(inFile, run.length) && run.length > 0;
+        if (ok) {
+            run.bits = (uint16_t)bits;
+            runs.push_back(run);
+            tickCount += run.length;
+        }
+    }
+
+    if (!ok) {
+        std::cerr << "Replay file is truncated or corrupt: " << path << std::endl;
+        runs.clear();
+        tickCount = 0;
+        return false;
+    }
+
+    tuning = loaded;
+    playRun = 0;
+    playOffset = 0;
+    return true;
+}
+
+bool Replay::next(uint16_t& bits) {
+    if (isFinished()) return false;
+
+    bits = runs[playRun].bits;
+    if (++playOffset >= runs[playRun].length) {
+        playRun++;
+        playOffset = 0;
+    }
+    return true;
+}
+
+bool Replay::isFinished() const {
+    return playRun >= runs.size();
+}
+
+bool Replay::matchesTuning(const WorldTuning& current) const {
+    return tuning.tickRate == current.tickRate
+        && tuning.screenWidth == current.screenWidth
+        && tuning.screenHeight == current.screenHeight
+        && tuning.cameraThreshold == current.cameraThreshold
+        && tuning.breakTicks == current.breakTicks
+        && tuning.stepX == current.stepX
+        && tuning.gravity == current.gravity
+        && tuning.jumpStrength == current.jumpStrength
+        && tuning.movingSpeed == current.movingSpeed;
+}
+
+InputState Replay::toInputState(uint16_t bits) {
+    InputState input;
+    input.left = (bits & REPLAY_INPUT_LEFT) != 0;
+    input.right = (bits & REPLAY_INPUT_RIGHT) != 0;
+    input.leftHold = (uint8_t)(INPUT_HOLD_STEPS - ((bits >> REPLAY_LEFT_HOLD_SHIFT) & 7));
+    input.rightHold = (uint8_t)(INPUT_HOLD_STEPS - ((bits >> REPLAY_RIGHT_HOLD_SHIFT) & 7));
+    return input;
+}
+
+uint16_t Replay::fromInputState(const InputState& input) {
+    uint16_t bits = 0;
+    if (input.left) {
+        bits |= REPLAY_INPUT_LEFT;
+        bits |= (uint16_t)((INPUT_HOLD_STEPS - input.leftHold) & 7) << REPLAY_LEFT_HOLD_SHIFT;
+    }
+    if (input.right) {
+        bits |= REPLAY_INPUT_RIGHT;
+        bits |= (uint16_t)((INPUT_HOLD_STEPS - input.rightHold) & 7) << REPLAY_RIGHT_HOLD_SHIFT;
+    }
+    return bits;
+}
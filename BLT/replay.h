@@ -0,0 +1,61 @@
+#ifndef REPLAY_H_INCLUDED
+#define REPLAY_H_INCLUDED
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "world.h"
+
+enum ReplayInput : uint16_t {
+    REPLAY_INPUT_LEFT = 1 << 0,
+    REPLAY_INPUT_RIGHT = 1 << 1,
+    REPLAY_INPUT_MUTE = 1 << 2
+};
+
+// Khi phím chỉ được giữ một phần tick, mã input lưu thêm INPUT_HOLD_STEPS - số nấc giữ
+// (3 bit mỗi phím); giữ trọn tick thì phần này bằng 0 nên đa số tick chỉ tốn một byte.
+const int REPLAY_LEFT_HOLD_SHIFT = 3;
+const int REPLAY_RIGHT_HOLD_SHIFT = 6;
+
+// Ghi lại input của từng tick để phát lại y hệt một phiên chơi.
+// File gồm: "BLTR", phiên bản, seed, độ cao bắt đầu, WorldTuning, rồi các đoạn RLE (mã input + số tick lặp lại).
+// Người chơi thường giữ nguyên phím trong nhiều tick nên mỗi phút chơi chỉ tốn vài trăm byte.
+class Replay {
+private:
+    static constexpr uint32_t FORMAT_VERSION = 1;
+
+    struct Run {
+        uint16_t bits;
+        uint32_t length;
+    };
+
+    uint64_t seed;
+    double startHeight;
+    WorldTuning tuning;
+    std::vector<Run> runs;
+    uint64_t tickCount;
+
+    size_t playRun;
+    uint32_t playOffset;
+
+public:
+    Replay();
+
+    void startRecording(uint64_t seed, double startHeight, const WorldTuning& tuning);
+    void record(uint16_t bits);
+    bool save(const std::string& path) const;
+
+    bool load(const std::string& path);
+    bool next(uint16_t& bits);
+    bool isFinished() const;
+    bool matchesTuning(const WorldTuning& current) const;
+
+    uint64_t getSeed() const { return seed; }
+    double getStartHeight() const { return startHeight; }
+    uint64_t getTickCount() const { return tickCount; }
+    const WorldTuning& getTuning() const { return tuning; }
+
+    static InputState toInputState(uint16_t bits);
+    static uint16_t fromInputState(const InputState& input);
+};
+
+#endif // REPLAY_H_INCLUDED
@@ -0,0 +1,48 @@
+#ifndef RNG_H_INCLUDED
+#define RNG_H_INCLUDED
+#include <cstdint>
+
+// PCG32 (O'Neill, pcg-random.org): nguồn ngẫu nhiên duy nhất của phần sinh màn chơi.
+// Chỉ dùng phép toán số nguyên nên cùng seed cho cùng kết quả trên mọi nền tảng,
+// khác với std::uniform_int_distribution vốn tuỳ thuộc thư viện chuẩn.
+class Rng {
+private:
+    uint64_t state;
+    uint64_t increment;
+
+public:
+    Rng() { seed(0); }
+    explicit Rng(uint64_t seedValue, uint64_t stream = 0) { seed(seedValue, stream); }
+
+    void seed(uint64_t seedValue, uint64_t stream = 0) {
+        state = 0;
+        increment = (stream << 1) | 1u;
+        next();
+        state += seedValue;
+        next();
+    }
+
+    uint32_t next() {
+        uint64_t oldState = state;
+        state = oldState * 6364136223846793005ULL + increment;
+        uint32_t xorShifted = (uint32_t)(((oldState >> 18) ^ oldState) >> 27);
+        uint32_t rotation = (uint32_t)(oldState >> 59);
+        return (xorShifted >> rotation) | (xorShifted << ((32 - rotation) & 31));
+    }
+
+    // Số nguyên đều trong [0, bound), không lệch (loại bỏ phần dư như pcg32_boundedrand)
+    uint32_t bounded(uint32_t bound) {
+        uint32_t threshold = (0u - bound) % bound;
+        for (;;) {
+            uint32_t value = next();
+            if (value >= threshold) return value % bound;
+        }
+    }
+
+    // Số nguyên đều trong [low, high]
+    int range(int low, int high) {
+        return low + (int)bounded((uint32_t)(high - low) + 1u);
+    }
+};
+
+#endif // RNG_H_INCLUDED
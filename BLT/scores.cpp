@@ -0,0 +1,352 @@
+#include "scores.h"
+#include "binio.h"
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+static const char TABLE_MAGIC[4] = {'B', 'L', 'T', 'S'};
+static const char LOG_MAGIC[4] = {'B', 'L', 'T', 'L'};
+static const size_t ENTRY_BYTES = 8 + 4 + 8 + 4 + 4 + 8;
+
+static void writeEntry(std::ostream& out, const ScoreEntry& entry) {
+    writeU64(out, entry.sequence);
+    writeU32(out, (uint32_t)entry.score);
+    writeU64(out, entry.seed);
+    writeU32(out, entry.durationTicks);
+    writeU32(out, (uint32_t)entry.maxDifficulty);
+    writeU64(out, (uint64_t)entry.timestamp);
+}
+
+static bool readEntry(std::istream& in, ScoreEntry& entry) {
+    uint64_t timestamp = 0;
+    bool ok = readU64(in, entry.sequence)
+        && readI32(in, entry.score)
+        && readU64(in, entry.seed)
+        && readU32(in, entry.durationTicks)
+        && readI32(in, entry.maxDifficulty)
+        && readU64(in, timestamp);
+    entry.timestamp = (int64_t)timestamp;
+    return ok;
+}
+
+// Đẩy nội dung file xuống đĩa; close() chỉ đưa dữ liệu vào cache của hệ điều hành
+static bool syncFile(const std::string& path) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    bool ok = FlushFileBuffers(file) != 0;
+    CloseHandle(file);
+    return ok;
+#else
+    int fd = ::open(path.c_str(), O_WRONLY);
+    if (fd < 0) return false;
+    bool ok = fsync(fd) == 0;
+    ::close(fd);
+    return ok;
+#endif
+}
+
+// Đẩy mục thư mục chứa path xuống đĩa, để file vừa tạo hay vừa đổi tên không biến mất khi mất điện.
+// Windows không cần: MOVEFILE_WRITE_THROUGH đã chờ việc đổi tên ghi xong.
+static bool syncDirectoryOf(const std::string& path) {
+#ifdef _WIN32
+    (void)path;
+    return true;
+#else
+    size_t slash = path.find_last_of('/');
+    std::string directory = slash == std::string::npos ? "." : slash == 0 ? "/" : path.substr(0, slash);
+    int fd = ::open(directory.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    bool ok = fsync(fd) == 0;
+    ::close(fd);
+    return ok;
+#endif
+}
+
+// Đổi tên đè lên file cũ; trên Windows std::rename không cho đè nên phải dùng MoveFileEx
+static bool replaceFile(const std::string& from, const std::string& to) {
+#ifdef _WIN32
+    return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    return std::rename(from.c_str(), to.c_str()) == 0;
+#endif
+}
+
+ScoreBoard::ScoreBoard(const std::string& basePath, const std::string& legacyPath, size_t capacity) {
+    tablePath = basePath + ".bin";
+    logPath = basePath + ".log";
+    this->legacyPath = legacyPath;
+    this->capacity = std::max<size_t>(capacity, 1);
+    nextSequence = 1;
+    logRecords = 0;
+    logHasHeader = false;
+    writing = false;
+    stopping = false;
+}
+
+ScoreBoard::~ScoreBoard() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    queueChanged.notify_all();
+    if (worker.joinable()) worker.join();
+}
+
+void ScoreBoard::load() {
+    if (worker.joinable()) return;
+
+    uint64_t tableSequence = 0;
+    bool hadTable = loadTable(tableSequence);
+    bool hadLog = loadLog(tableSequence);
+    if (!hadTable && !hadLog && loadLegacy()) {
+        // Gộp ngay để điểm cũ có trong file mới
+        logRecords = COMPACT_AFTER;
+    }
+
+    worker = std::thread(&ScoreBoard::workerLoop, this);
+}
+
+bool ScoreBoard::insert(const ScoreEntry& entry) {
+    if (entries.size() >= capacity && entry.score <= entries.back().score) return false;
+
+    // Điểm bằng nhau thì lượt cũ đứng trước
+    auto position = std::upper_bound(entries.begin(), entries.end(), entry,
+                                     [](const ScoreEntry& a, const ScoreEntry& b) { return a.score > b.score; });
+    entries.insert(position, entry);
+    if (entries.size() > capacity) entries.pop_back();
+    return true;
+}
+
+bool ScoreBoard::loadTable(uint64_t& tableSequence) {
+    std::ifstream inFile(tablePath, std::ios::binary);
+    if (!inFile.is_open()) return false;
+
+    std::string bytes((std::istreambuf_iterator<char>(inFile)), std::istreambuf_iterator<char>());
+    std::string body = bytes.size() >= 8 ? bytes.substr(4, bytes.size() - 8) : std::string();
+
+    std::istringstream tail(bytes.size() >= 8 ? bytes.substr(bytes.size() - 4) : std::string());
+    uint32_t storedChecksum = 0;
+    if (bytes.size() < 8 || std::memcmp(bytes.data(), TABLE_MAGIC, sizeof(TABLE_MAGIC)) != 0
+        || !readU32(tail, storedChecksum) || storedChecksum != checksum(body)) {
+        std::cerr << "Score table " << tablePath << " is corrupt, ignoring it" << std::endl;
+        return false;
+    }
+
+    std::istringstream in(body);
+    uint32_t version = 0;
+    uint32_t count = 0;
+    if (!readU32(in, version) || version != FORMAT_VERSION || !readU64(in, tableSequence) || !readU32(in, count)) {
+        std::cerr << "Unsupported score table " << tablePath << std::endl;
+        tableSequence = 0;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(entriesMutex);
+    for (uint32_t i = 0; i < count; i++) {
+        ScoreEntry entry;
+        if (!readEntry(in, entry)) break;
+        insert(entry);
+    }
+    nextSequence = std::max(nextSequence, tableSequence + 1);
+    return true;
+}
+
+bool ScoreBoard::loadLog(uint64_t tableSequence) {
+    std::ifstream inFile(logPath, std::ios::binary);
+    if (!inFile.is_open()) return false;
+
+    char magic[4];
+    uint32_t version = 0;
+    if (!inFile.read(magic, sizeof(magic)) || std::memcmp(magic, LOG_MAGIC, sizeof(magic)) != 0
+        || !readU32(inFile, version) || version != FORMAT_VERSION) {
+        std::cerr << "Score log " << logPath << " is corrupt, it will be rewritten" << std::endl;
+        logRecords = COMPACT_AFTER;
+        return true;
+    }
+    logHasHeader = true;
+
+    std::lock_guard<std::mutex> lock(entriesMutex);
+    std::string record(ENTRY_BYTES, '\0');
+    while (inFile.read(&record[0], ENTRY_BYTES)) {
+        uint32_t storedChecksum = 0;
+        if (!readU32(inFile, storedChecksum) || storedChecksum != checksum(record)) {
+            // Bản ghi cuối bị cắt dở lúc máy tắt; ghi nối tiếp sau nó sẽ không đọc được nên gộp lại luôn
+            logRecords = COMPACT_AFTER;
+            break;
+        }
+
+        std::istringstream in(record);
+        ScoreEntry entry;
+        readEntry(in, entry);
+        logRecords++;
+
+        // Đã nằm trong bảng từ lần gộp trước (máy tắt trước khi kịp xoá log)
+        if (entry.sequence <= tableSequence) continue;
+        insert(entry);
+        nextSequence = std::max(nextSequence, entry.sequence + 1);
+    }
+    if (inFile.gcount() > 0) logRecords = COMPACT_AFTER;
+    return true;
+}
+
+bool ScoreBoard::loadLegacy() {
+    std::ifstream inFile(legacyPath);
+    int legacyScore = 0;
+    if (!inFile.is_open() || !(inFile >> legacyScore) || legacyScore <= 0) return false;
+
+    ScoreEntry entry = {};
+    entry.score = legacyScore;
+    std::lock_guard<std::mutex> lock(entriesMutex);
+    entry.sequence = nextSequence++;
+    insert(entry);
+    std::cout << "Imported best score " << legacyScore << " from " << legacyPath << std::endl;
+    return true;
+}
+
+bool ScoreBoard::appendToLog(const ScoreEntry& entry) {
+    std::ofstream outFile(logPath, logHasHeader ? std::ios::binary | std::ios::app : std::ios::binary | std::ios::trunc);
+    if (!outFile.is_open()) return false;
+
+    if (!logHasHeader) {
+        outFile.write(LOG_MAGIC, sizeof(LOG_MAGIC));
+        writeU32(outFile, FORMAT_VERSION);
+    }
+
+    std::ostringstream record;
+    writeEntry(record, entry);
+    outFile.write(record.str().data(), record.str().size());
+    writeU32(outFile, checksum(record.str()));
+    outFile.close();
+
+    // Chỉ coi là đã lưu khi bản ghi thật sự nằm trên đĩa; file log mới tạo thì cả thư mục cũng phải được ghi
+    if (!outFile || !syncFile(logPath)) return false;
+    if (!logHasHeader && !syncDirectoryOf(logPath)) return false;
+    logHasHeader = true;
+    return true;
+}
+
+bool ScoreBoard::compact() {
+    std::vector<ScoreEntry> snapshot;
+    uint64_t tableSequence;
+    {
+        std::lock_guard<std::mutex> lock(entriesMutex);
+        snapshot = entries;
+        tableSequence = nextSequence - 1;
+    }
+
+    std::ostringstream body;
+    writeU32(body, FORMAT_VERSION);
+    writeU64(body, tableSequence);
+    writeU32(body, (uint32_t)snapshot.size());
+    for (const ScoreEntry& entry : snapshot) {
+        writeEntry(body, entry);
+    }
+
+    std::string tempPath = tablePath + ".tmp";
+    {
+        std::ofstream outFile(tempPath, std::ios::binary | std::ios::trunc);
+        outFile.write(TABLE_MAGIC, sizeof(TABLE_MAGIC));
+        outFile.write(body.str().data(), body.str().size());
+        writeU32(outFile, checksum(body.str()));
+        outFile.close();
+        // Phải nằm trên đĩa trước khi đổi tên, nếu không mất điện có thể để lại bảng rỗng thay cho bảng cũ
+        if (!outFile || !syncFile(tempPath)) {
+            std::cerr << "Failed to write score table " << tempPath << std::endl;
+            return false;
+        }
+    }
+    if (!replaceFile(tempPath, tablePath)) {
+        std::cerr << "Failed to replace score table " << tablePath << std::endl;
+        return false;
+    }
+    // Chưa ghi việc đổi tên xuống đĩa thì chưa được xoá log
+    if (!syncDirectoryOf(tablePath)) {
+        std::cerr << "Failed to sync the directory of " << tablePath << std::endl;
+        return false;
+    }
+
+    // Bảng mới đã chứa mọi bản ghi trong log; nếu máy tắt trước bước này thì lần sau bỏ qua chúng theo sequence
+    logHasHeader = false;
+    std::ofstream logFile(logPath, std::ios::binary | std::ios::trunc);
+    logFile.write(LOG_MAGIC, sizeof(LOG_MAGIC));
+    writeU32(logFile, FORMAT_VERSION);
+    logFile.close();
+    logHasHeader = (bool)logFile;
+    return true;
+}
+
+void ScoreBoard::workerLoop() {
+    std::unique_lock<std::mutex> lock(queueMutex);
+    while (true) {
+        queueChanged.wait(lock, [this] { return stopping || !pending.empty() || logRecords >= COMPACT_AFTER; });
+        if (pending.empty() && logRecords < COMPACT_AFTER) return;
+
+        std::deque<ScoreEntry> batch;
+        batch.swap(pending);
+        writing = true;
+        lock.unlock();
+
+        for (const ScoreEntry& entry : batch) {
+            if (appendToLog(entry)) {
+                logRecords++;
+            } else {
+                std::cerr << "Failed to append to score log " << logPath << std::endl;
+                logRecords = COMPACT_AFTER;
+            }
+        }
+
+        // Gộp lỗi thì thử lại sau COMPACT_AFTER lượt nữa, tránh lặp mãi khi ổ đĩa hỏng
+        if (logRecords >= COMPACT_AFTER) {
+            compact();
+            logRecords = 0;
+        }
+
+        lock.lock();
+        writing = false;
+        queueChanged.notify_all();
+    }
+}
+
+bool ScoreBoard::submit(ScoreEntry entry) {
+    if (entry.timestamp == 0) entry.timestamp = (int64_t)std::time(nullptr);
+
+    {
+        std::lock_guard<std::mutex> lock(entriesMutex);
+        entry.sequence = nextSequence++;
+        if (!insert(entry)) return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        pending.push_back(entry);
+    }
+    queueChanged.notify_all();
+    return true;
+}
+
+void ScoreBoard::flush() {
+    std::unique_lock<std::mutex> lock(queueMutex);
+    queueChanged.wait(lock, [this] { return !worker.joinable() || (pending.empty() && !writing); });
+}
+
+int ScoreBoard::getBestScore() const {
+    std::lock_guard<std::mutex> lock(entriesMutex);
+    return entries.empty() ? 0 : entries.front().score;
+}
+
+std::vector<ScoreEntry> ScoreBoard::getEntries() const {
+    std::lock_guard<std::mutex> lock(entriesMutex);
+    return entries;
+}
@@ -0,0 +1,81 @@
+#ifndef SCORES_H_INCLUDED
+#define SCORES_H_INCLUDED
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Một lượt chơi trong bảng điểm. sequence tăng dần theo thứ tự ghi, dùng để bỏ các bản ghi
+// trong log đã được gộp vào bảng (khi máy tắt giữa lúc gộp).
+struct ScoreEntry {
+    uint64_t sequence;
+    int32_t score;
+    uint64_t seed;
+    uint32_t durationTicks;
+    int32_t maxDifficulty;
+    int64_t timestamp;
+};
+
+// Bảng N điểm cao nhất, lưu trên đĩa bằng một luồng nền để lúc thua không bị khựng vì ổ đĩa chậm.
+//   <base>.bin: bảng đã gộp, chỉ được thay bằng cách ghi file tạm rồi đổi tên, nên luôn nguyên vẹn.
+//   <base>.log: các lượt mới được ghi nối đuôi, mỗi bản ghi có checksum; bản ghi dở dang khi
+//               máy tắt đột ngột bị bỏ qua. Đủ COMPACT_AFTER bản ghi thì gộp vào <base>.bin.
+// Lần đầu chạy, điểm cao trong highscore.txt cũ được chuyển sang.
+class ScoreBoard {
+private:
+    static constexpr uint32_t FORMAT_VERSION = 1;
+    static constexpr size_t COMPACT_AFTER = 16;
+
+    std::string tablePath;
+    std::string logPath;
+    std::string legacyPath;
+    size_t capacity;
+
+    // entries và nextSequence dùng chung giữa luồng game và luồng ghi
+    mutable std::mutex entriesMutex;
+    std::vector<ScoreEntry> entries;
+    uint64_t nextSequence;
+
+    // Chỉ luồng ghi dùng (trừ lúc load, khi luồng ghi chưa chạy)
+    size_t logRecords;
+    bool logHasHeader;
+
+    std::thread worker;
+    std::mutex queueMutex;
+    std::condition_variable queueChanged;
+    std::deque<ScoreEntry> pending;
+    bool writing;
+    bool stopping;
+
+    bool insert(const ScoreEntry& entry);
+    bool loadTable(uint64_t& tableSequence);
+    bool loadLog(uint64_t tableSequence);
+    bool loadLegacy();
+    bool appendToLog(const ScoreEntry& entry);
+    bool compact();
+    void workerLoop();
+
+public:
+    ScoreBoard(const std::string& basePath, const std::string& legacyPath, size_t capacity = 10);
+    ~ScoreBoard();
+
+    ScoreBoard(const ScoreBoard&) = delete;
+    ScoreBoard& operator=(const ScoreBoard&) = delete;
+
+    // Đọc bảng điểm lúc khởi động (đồng bộ) rồi mới bắt đầu luồng ghi
+    void load();
+
+    // Không chờ ổ đĩa: cập nhật bảng trong bộ nhớ ngay, việc ghi để luồng nền làm.
+    // Trả về true nếu lượt này lọt vào bảng.
+    bool submit(ScoreEntry entry);
+    // Chờ luồng nền ghi xong mọi lượt đã gửi
+    void flush();
+
+    int getBestScore() const;
+    std::vector<ScoreEntry> getEntries() const;
+};
+
+#endif // SCORES_H_INCLUDED
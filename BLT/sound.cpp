@@ -0,0 +1,125 @@
+#include "sound.h"
+#include <iostream>
+
+SoundManager::SoundManager(int soundCount) : sounds(soundCount) {
+    for (std::atomic<Mix_Chunk*>& sound : sounds) {
+        sound = nullptr;
+    }
+    isOpen = false;
+    muted = false;
+    voices = 0;
+    frequency = 0;
+    bufferSamples = 0;
+    measuring = false;
+    pendingPlay = 0;
+    lastMix = 0;
+    mixIntervalSum = 0.0;
+    mixIntervalCount = 0;
+    playDelayCount = 0;
+}
+
+SoundManager::~SoundManager() {
+    if (isOpen) {
+        Mix_SetPostMix(NULL, NULL);
+        Mix_HaltChannel(-1);
+    }
+    for (std::atomic<Mix_Chunk*>& sound : sounds) {
+        Mix_Chunk* chunk = sound.exchange(nullptr);
+        if (chunk) Mix_FreeChunk(chunk);
+    }
+    if (isOpen) Mix_CloseAudio();
+}
+
+bool SoundManager::open(int bufferSamples, int voices) {
+    if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, bufferSamples) < 0) {
+        std::cerr << "SDL_mixer could not initialize! SDL_mixer Error: " << Mix_GetError() << std::endl;
+        return false;
+    }
+    isOpen = true;
+    this->bufferSamples = bufferSamples;
+    this->voices = Mix_AllocateChannels(voices);
+
+    Uint16 format;
+    int channels;
+    if (!Mix_QuerySpec(&frequency, &format, &channels)) frequency = 44100;
+    SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO, "Audio: %d Hz, %d channels, %d-sample buffer (%.1f ms), %d voices",
+                   frequency, channels, bufferSamples, getBufferMs(), this->voices);
+    return true;
+}
+
+void SoundManager::setSound(int id, Mix_Chunk* chunk) {
+    if (id < 0 || id >= (int)sounds.size()) {
+        if (chunk) Mix_FreeChunk(chunk);
+        return;
+    }
+    Mix_Chunk* old = sounds[id].exchange(chunk);
+    if (old) Mix_FreeChunk(old);
+}
+
+void SoundManager::play(int id) {
+    if (!isOpen || muted || id < 0 || id >= (int)sounds.size()) return;
+    Mix_Chunk* chunk = sounds[id];
+    if (!chunk) return;
+
+    int channel = Mix_PlayChannel(-1, chunk, 0);
+    if (channel < 0) {
+        // Mọi kênh đang bận: cắt kênh đã phát lâu nhất, phần đuôi của nó ít nghe thấy nhất
+        int oldest = Mix_GroupOldest(-1);
+        if (oldest < 0) return;
+        Mix_HaltChannel(oldest);
+        channel = Mix_PlayChannel(oldest, chunk, 0);
+    }
+    if (channel >= 0 && measuring) {
+        Uint64 expected = 0;
+        pendingPlay.compare_exchange_strong(expected, SDL_GetPerformanceCounter());
+    }
+}
+
+// Tắt tiếng bằng âm lượng của mọi kênh (các kênh đang phát im ngay), và không mở kênh mới khi đang tắt
+void SoundManager::setMuted(bool muted) {
+    this->muted = muted;
+    if (isOpen) Mix_Volume(-1, muted ? 0 : MIX_MAX_VOLUME);
+}
+
+void SoundManager::setMeasuring(bool enabled) {
+    if (!isOpen) return;
+    measuring = enabled;
+    Mix_SetPostMix(enabled ? &SoundManager::postMix : NULL, this);
+}
+
+// Chạy trên luồng âm thanh mỗi khi SDL_mixer trộn xong một bộ đệm
+void SoundManager::postMix(void* udata, Uint8* stream, int length) {
+    (void)stream;
+    (void)length;
+    SoundManager* manager = (SoundManager*)udata;
+    Uint64 now = SDL_GetPerformanceCounter();
+    double countsPerMs = SDL_GetPerformanceFrequency() / 1000.0;
+
+    if (manager->lastMix != 0) {
+        manager->mixIntervalSum += (now - manager->lastMix) / countsPerMs;
+        manager->mixIntervalCount++;
+    }
+    manager->lastMix = now;
+
+    Uint64 requested = manager->pendingPlay.exchange(0);
+    if (requested != 0) {
+        float delay = (float)((now - requested) / countsPerMs);
+        if (manager->playDelays.size() < MAX_DELAY_SAMPLES) manager->playDelays.push_back(delay);
+        else manager->playDelays[manager->playDelayCount % MAX_DELAY_SAMPLES] = delay;
+        manager->playDelayCount++;
+    }
+}
+
+std::vector<float> SoundManager::stopMeasuring() {
+    // Mix_SetPostMix khoá luồng âm thanh nên sau đó đọc số liệu không còn bị tranh chấp
+    setMeasuring(false);
+    return playDelays;
+}
+
+double SoundManager::getBufferMs() const {
+    return frequency > 0 ? 1000.0 * bufferSamples / frequency : 0.0;
+}
+
+double SoundManager::getMixIntervalMs() const {
+    return mixIntervalCount > 0 ? mixIntervalSum / mixIntervalCount : 0.0;
+}
@@ -0,0 +1,62 @@
+#ifndef SOUND_H_INCLUDED
+#define SOUND_H_INCLUDED
+#include <SDL.h>
+#include <SDL_mixer.h>
+#include <atomic>
+#include <vector>
+
+// Âm thanh hiệu ứng: mở thiết bị với bộ đệm nhỏ cho độ trễ thấp, giữ sẵn PCM đã giải mã
+// (đúng định dạng của thiết bị, nên lúc phát không phải chuyển đổi) và một số kênh cố định.
+// Hết kênh trống thì cắt kênh phát lâu nhất thay vì bỏ âm thanh mới.
+// play() gọi từ luồng mô phỏng; setSound() từ luồng chính khi bộ giải mã nền làm xong.
+class SoundManager {
+public:
+    static constexpr int DEFAULT_BUFFER_SAMPLES = 512;
+    static constexpr int DEFAULT_VOICES = 8;
+
+private:
+    static constexpr size_t MAX_DELAY_SAMPLES = 240;
+
+    std::vector<std::atomic<Mix_Chunk*>> sounds;
+    bool isOpen;
+    bool muted;
+    int voices;
+
+    int frequency;
+    int bufferSamples;
+
+    // Đo trên luồng âm thanh: thời điểm gọi play() tới lần trộn kế tiếp đưa nó vào bộ đệm
+    bool measuring;
+    std::atomic<Uint64> pendingPlay;
+    Uint64 lastMix;
+    double mixIntervalSum;
+    uint64_t mixIntervalCount;
+    std::vector<float> playDelays;
+    size_t playDelayCount;
+
+    static void postMix(void* udata, Uint8* stream, int length);
+
+public:
+    explicit SoundManager(int soundCount);
+    ~SoundManager();
+
+    SoundManager(const SoundManager&) = delete;
+    SoundManager& operator=(const SoundManager&) = delete;
+
+    // bufferSamples là số mẫu mỗi lần thiết bị lấy dữ liệu; nhỏ thì trễ ít nhưng dễ rè trên máy yếu
+    bool open(int bufferSamples = DEFAULT_BUFFER_SAMPLES, int voices = DEFAULT_VOICES);
+
+    // Nhận quyền sở hữu chunk
+    void setSound(int id, Mix_Chunk* chunk);
+    void play(int id);
+    void setMuted(bool muted);
+
+    // Đo độ trễ phát; chỉ bật trong chế độ --latency
+    void setMeasuring(bool enabled);
+    // Ngừng đo rồi trả về các mẫu độ trễ (ms) từ play() tới lúc được trộn
+    std::vector<float> stopMeasuring();
+    double getBufferMs() const;
+    double getMixIntervalMs() const;
+};
+
+#endif // SOUND_H_INCLUDED
@@ -0,0 +1,144 @@
+#include "streamer.h"
+
+ChunkStreamer::ChunkStreamer(int screenWidth, int platformWidth) {
+    this->screenWidth = screenWidth;
+    this->platformWidth = platformWidth;
+    readCount = 0;
+    writeCount = 0;
+    requestSeed = 0;
+    requestIndex = 0;
+    requestVersion = 0;
+    stopping = false;
+    sleeping = false;
+
+    worker = std::thread(&ChunkStreamer::workerLoop, this);
+}
+
+ChunkStreamer::~ChunkStreamer() {
+    stopping = true;
+    wakeWorker();
+    worker.join();
+}
+
+// Gọi sau khi đã ghi xong hàng đợi hay yêu cầu. Luồng nền chỉ ngủ khi hàng đợi đầy hoặc chưa có yêu cầu,
+// nên thường cờ sleeping tắt và không phải đụng tới mutex. Hai fence seq_cst (ở đây và trong workerLoop)
+// bảo đảm: hoặc luồng nền thấy thay đổi trước khi ngủ, hoặc ở đây thấy cờ bật và đánh thức nó.
+void ChunkStreamer::wakeWorker() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!sleeping.load(std::memory_order_relaxed)) return;
+
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+    }
+    wake.notify_one();
+}
+
+uint64_t ChunkStreamer::cacheKey(uint64_t seed, int index) {
+    return seed ^ ((uint64_t)(uint32_t)index * 0x9E3779B97F4A7C15ULL);
+}
+
+const LevelChunk& ChunkStreamer::getOrGenerate(uint64_t seed, int index) {
+    uint64_t key = cacheKey(seed, index);
+    auto found = cacheIndex.find(key);
+    if (found != cacheIndex.end()) {
+        const LevelChunk& cached = *found->second;
+        if (cached.seed == seed && cached.index == index) {
+            cache.splice(cache.begin(), cache, found->second);
+            return cache.front();
+        }
+        cache.erase(found->second);
+        cacheIndex.erase(found);
+    }
+
+    if (cache.size() >= CACHE_CAPACITY) {
+        cacheIndex.erase(cacheKey(cache.back().seed, cache.back().index));
+        cache.pop_back();
+    }
+
+    cache.emplace_front();
+    generateChunk(seed, index, screenWidth, platformWidth, cache.front());
+    cacheIndex[key] = cache.begin();
+    return cache.front();
+}
+
+void ChunkStreamer::workerLoop() {
+    uint32_t seenVersion = 0;
+    uint64_t seed = 0;
+    int nextIndex = 0;
+    bool hasRequest = false;
+
+    while (!stopping) {
+        uint32_t version = requestVersion.load(std::memory_order_acquire);
+        if (version != seenVersion && (version & 1) == 0) {
+            uint64_t newSeed = requestSeed.load(std::memory_order_relaxed);
+            int newIndex = requestIndex.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            // Luồng mô phỏng vừa đổi yêu cầu giữa chừng thì đọc lại ở vòng sau
+            if (requestVersion.load(std::memory_order_relaxed) == version) {
+                seenVersion = version;
+                seed = newSeed;
+                nextIndex = newIndex;
+                hasRequest = true;
+            }
+            continue;
+        }
+        if (version & 1) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        uint32_t written = writeCount.load(std::memory_order_relaxed);
+        uint32_t read = readCount.load(std::memory_order_acquire);
+        if (hasRequest && written - read < QUEUE_SIZE) {
+            queue[written % QUEUE_SIZE] = getOrGenerate(seed, nextIndex);
+            nextIndex++;
+            writeCount.store(written + 1, std::memory_order_release);
+            continue;
+        }
+
+        // Hàng đợi đầy hoặc chưa có yêu cầu: ngủ tới khi luồng mô phỏng lấy bớt hay đổi yêu cầu.
+        // Ở menu và màn hình thua không ai lấy chunk nên luồng này ngủ yên.
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        sleeping.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        wake.wait(lock, [&] {
+            if (stopping || requestVersion.load(std::memory_order_acquire) != seenVersion) return true;
+            uint32_t queued = writeCount.load(std::memory_order_relaxed) - readCount.load(std::memory_order_acquire);
+            return hasRequest && queued < QUEUE_SIZE;
+        });
+        sleeping.store(false, std::memory_order_relaxed);
+    }
+}
+
+// Seqlock: phiên bản lẻ nghĩa là đang ghi dở, luồng nền sẽ đọc lại sau
+void ChunkStreamer::request(uint64_t seed, int index) {
+    uint32_t version = requestVersion.load(std::memory_order_relaxed);
+    requestVersion.store(version + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    requestSeed.store(seed, std::memory_order_relaxed);
+    requestIndex.store(index, std::memory_order_relaxed);
+    requestVersion.store(version + 2, std::memory_order_release);
+    wakeWorker();
+}
+
+bool ChunkStreamer::take(uint64_t seed, int index, LevelChunk& out) {
+    uint32_t read = readCount.load(std::memory_order_relaxed);
+    uint32_t written = writeCount.load(std::memory_order_acquire);
+
+    bool found = false;
+    while (read != written) {
+        const LevelChunk& chunk = queue[read % QUEUE_SIZE];
+        read++;
+        if (chunk.seed == seed && chunk.index == index) {
+            out = chunk;
+            found = true;
+            break;
+        }
+    }
+
+    readCount.store(read, std::memory_order_release);
+    wakeWorker();
+    return found;
+}
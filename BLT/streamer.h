@@ -0,0 +1,63 @@
+#ifndef STREAMER_H_INCLUDED
+#define STREAMER_H_INCLUDED
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include "chunk.h"
+
+// Sinh trước các chunk phía trên camera trên một luồng nền.
+// Luồng nền đẩy chunk vào hàng đợi vòng một-ghi-một-đọc; luồng mô phỏng lấy ra mà không khoá.
+// Nếu chunk cần chưa có sẵn, PlatformManager tự sinh luôn: chunk là hàm thuần của (seed, index)
+// nên kết quả không phụ thuộc luồng nền chạy nhanh hay chậm.
+class ChunkStreamer {
+private:
+    static constexpr uint32_t QUEUE_SIZE = 4;
+    static constexpr size_t CACHE_CAPACITY = 16;
+
+    int screenWidth;
+    int platformWidth;
+
+    // Hàng đợi vòng: chỉ luồng nền ghi writeCount, chỉ luồng mô phỏng ghi readCount
+    LevelChunk queue[QUEUE_SIZE];
+    std::atomic<uint32_t> readCount;
+    std::atomic<uint32_t> writeCount;
+
+    // Vị trí luồng mô phỏng sẽ đọc tiếp; đổi theo kiểu seqlock với requestVersion
+    std::atomic<uint64_t> requestSeed;
+    std::atomic<int32_t> requestIndex;
+    std::atomic<uint32_t> requestVersion;
+
+    // Bộ nhớ đệm LRU, chỉ luồng nền dùng; giúp khi khôi phục snapshot quay về chunk cũ
+    std::list<LevelChunk> cache;
+    std::unordered_map<uint64_t, std::list<LevelChunk>::iterator> cacheIndex;
+
+    std::thread worker;
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    std::atomic<bool> stopping;
+    // Luồng nền đang (hoặc sắp) ngủ; luồng mô phỏng chỉ khoá wakeMutex khi cờ này bật
+    std::atomic<bool> sleeping;
+
+    static uint64_t cacheKey(uint64_t seed, int index);
+    const LevelChunk& getOrGenerate(uint64_t seed, int index);
+    void wakeWorker();
+    void workerLoop();
+
+public:
+    ChunkStreamer(int screenWidth, int platformWidth);
+    ~ChunkStreamer();
+
+    ChunkStreamer(const ChunkStreamer&) = delete;
+    ChunkStreamer& operator=(const ChunkStreamer&) = delete;
+
+    // Báo cho luồng nền biết chunk tiếp theo luồng mô phỏng cần, khi bắt đầu màn mới hoặc nhảy cóc
+    void request(uint64_t seed, int index);
+    // Lấy chunk (seed, index) nếu đã sinh sẵn; bỏ qua các chunk cũ không còn cần
+    bool take(uint64_t seed, int index, LevelChunk& out);
+};
+
+#endif // STREAMER_H_INCLUDED
@@ -0,0 +1,132 @@
+#include "text.h"
+#include <iostream>
+#include <algorithm>
+
+TextRenderer::TextRenderer() {
+    renderer = nullptr;
+    font = nullptr;
+    batch = nullptr;
+    atlas = nullptr;
+    atlasHeight = 0;
+
+    for (auto& glyph : glyphs) {
+        glyph.src = {0, 0, 0, 0};
+        glyph.advance = 0;
+    }
+}
+
+TextRenderer::~TextRenderer() {
+    for (auto& entry : cache) {
+        SDL_DestroyTexture(entry.second.texture);
+    }
+    if (atlas) SDL_DestroyTexture(atlas);
+}
+
+bool TextRenderer::init(SDL_Renderer* renderer, TTF_Font* font, SpriteBatch* batch) {
+    this->renderer = renderer;
+    this->font = font;
+    this->batch = batch;
+
+    const int glyphCount = LAST_GLYPH - FIRST_GLYPH + 1;
+    const SDL_Color white = {255, 255, 255, 255};
+    SDL_Surface* glyphSurfaces[glyphCount];
+
+    // Xếp glyph theo từng hàng để biết chiều cao atlas trước khi tạo surface
+    int penX = 0;
+    int penY = 0;
+    int rowHeight = 0;
+
+    for (int i = 0; i < glyphCount; i++) {
+        char text[2] = {(char)(FIRST_GLYPH + i), '\0'};
+        glyphSurfaces[i] = TTF_RenderText_Blended(font, text, white);
+
+        int minX, maxX, minY, maxY, advance;
+        if (TTF_GlyphMetrics(font, FIRST_GLYPH + i, &minX, &maxX, &minY, &maxY, &advance) != 0) {
+            advance = glyphSurfaces[i] ? glyphSurfaces[i]->w : 0;
+        }
+        glyphs[i].advance = advance;
+
+        if (!glyphSurfaces[i]) continue;
+
+        if (penX + glyphSurfaces[i]->w > ATLAS_WIDTH) {
+            penX = 0;
+            penY += rowHeight + 1;
+            rowHeight = 0;
+        }
+
+        glyphs[i].src = {penX, penY, glyphSurfaces[i]->w, glyphSurfaces[i]->h};
+        penX += glyphSurfaces[i]->w + 1;
+        rowHeight = std::max(rowHeight, glyphSurfaces[i]->h);
+    }
+    atlasHeight = penY + rowHeight;
+
+    SDL_Surface* atlasSurface = SDL_CreateRGBSurfaceWithFormat(0, ATLAS_WIDTH, atlasHeight, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!atlasSurface) {
+        std::cerr << "Unable to create glyph atlas surface! SDL Error: " << SDL_GetError() << std::endl;
+        for (auto surface : glyphSurfaces) {
+            if (surface) SDL_FreeSurface(surface);
+        }
+        return false;
+    }
+    SDL_FillRect(atlasSurface, NULL, SDL_MapRGBA(atlasSurface->format, 255, 255, 255, 0));
+
+    for (int i = 0; i < glyphCount; i++) {
+        if (!glyphSurfaces[i]) continue;
+
+        SDL_SetSurfaceBlendMode(glyphSurfaces[i], SDL_BLENDMODE_NONE);
+        SDL_Rect dest = glyphs[i].src;
+        SDL_BlitSurface(glyphSurfaces[i], NULL, atlasSurface, &dest);
+        SDL_FreeSurface(glyphSurfaces[i]);
+    }
+
+    atlas = SDL_CreateTextureFromSurface(renderer, atlasSurface);
+    SDL_FreeSurface(atlasSurface);
+    if (!atlas) {
+        std::cerr << "Unable to create glyph atlas texture! SDL Error: " << SDL_GetError() << std::endl;
+        return false;
+    }
+    SDL_SetTextureBlendMode(atlas, SDL_BLENDMODE_BLEND);
+    return true;
+}
+
+void TextRenderer::draw(const std::string& text, int x, int y, SDL_Color color, float scale) {
+    if (!atlas) return;
+
+    float penX = (float)x;
+    for (char c : text) {
+        int index = (unsigned char)c - FIRST_GLYPH;
+        if (index < 0 || index > LAST_GLYPH - FIRST_GLYPH) continue;
+
+        const Glyph& glyph = glyphs[index];
+        if (glyph.src.w > 0) {
+            SDL_FRect dest = {penX, (float)y, glyph.src.w * scale, glyph.src.h * scale};
+            batch->draw(atlas, glyph.src, dest, color);
+        }
+
+        penX += glyph.advance * scale;
+    }
+}
+
+void TextRenderer::drawCached(const std::string& text, int x, int y, SDL_Color color) {
+    auto it = cache.find(text);
+
+    if (it == cache.end()) {
+        SDL_Surface* textSurface = TTF_RenderText_Blended(font, text.c_str(), {255, 255, 255, 255});
+        if (!textSurface) {
+            std::cerr << "Unable to render text surface! SDL_ttf Error: " << TTF_GetError() << std::endl;
+            return;
+        }
+        SDL_Texture* textTexture = SDL_CreateTextureFromSurface(renderer, textSurface);
+        CachedText cached = {textTexture, textSurface->w, textSurface->h};
+        SDL_FreeSurface(textSurface);
+        if (!textTexture) {
+            std::cerr << "Unable to create texture from rendered text! SDL Error: " << SDL_GetError() << std::endl;
+            return;
+        }
+        it = cache.emplace(text, cached).first;
+    }
+
+    SDL_Rect src = {0, 0, it->second.width, it->second.height};
+    SDL_FRect dest = {(float)x, (float)y, (float)it->second.width, (float)it->second.height};
+    batch->draw(it->second.texture, src, dest, color);
+}
@@ -0,0 +1,46 @@
+#ifndef TEXT_H_INCLUDED
+#define TEXT_H_INCLUDED
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <string>
+#include <unordered_map>
+#include "batch.h"
+
+// Vẽ chữ từ một atlas glyph tạo sẵn lúc khởi động, thay vì rasterize lại mỗi frame.
+class TextRenderer {
+private:
+    static const int FIRST_GLYPH = 32;
+    static const int LAST_GLYPH = 126;
+    static const int ATLAS_WIDTH = 512;
+
+    struct Glyph {
+        SDL_Rect src;
+        int advance;
+    };
+
+    struct CachedText {
+        SDL_Texture* texture;
+        int width;
+        int height;
+    };
+
+    SDL_Renderer* renderer;
+    TTF_Font* font;
+    SpriteBatch* batch;
+    SDL_Texture* atlas;
+    int atlasHeight;
+    Glyph glyphs[LAST_GLYPH - FIRST_GLYPH + 1];
+
+    std::unordered_map<std::string, CachedText> cache;
+
+public:
+    TextRenderer();
+    ~TextRenderer();
+
+    bool init(SDL_Renderer* renderer, TTF_Font* font, SpriteBatch* batch);
+
+    void draw(const std::string& text, int x, int y, SDL_Color color, float scale = 1.0f);
+    void drawCached(const std::string& text, int x, int y, SDL_Color color);
+};
+
+#endif // TEXT_H_INCLUDED
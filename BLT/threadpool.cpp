@@ -0,0 +1,114 @@
+#include "threadpool.h"
+#include <algorithm>
+
+ThreadPool::ThreadPool(int threadCount) {
+    if (threadCount <= 0) {
+        threadCount = std::max(1, (int)std::thread::hardware_concurrency());
+    }
+
+    // Hàng đợi 0 thuộc về luồng gọi parallelFor, các hàng còn lại thuộc về worker
+    queueCount = threadCount;
+    queues.reset(new WorkQueue[queueCount]);
+    queuedTasks = 0;
+    pendingTasks = 0;
+    stopping = false;
+
+    for (int i = 1; i < queueCount; i++) {
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+bool ThreadPool::popTask(int queueIndex, Task& task) {
+    WorkQueue& queue = queues[queueIndex];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) return false;
+
+    task = queue.tasks.back();
+    queue.tasks.pop_back();
+    queuedTasks--;
+    return true;
+}
+
+bool ThreadPool::stealTask(int thiefIndex, Task& task) {
+    for (int offset = 1; offset < queueCount; offset++) {
+        WorkQueue& queue = queues[(thiefIndex + offset) % queueCount];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) continue;
+
+        task = queue.tasks.front();
+        queue.tasks.pop_front();
+        queuedTasks--;
+        return true;
+    }
+    return false;
+}
+
+void ThreadPool::runTask(const Task& task) {
+    (*task.body)(task.begin, task.end);
+
+    if (--pendingTasks == 0) {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        workFinished.notify_all();
+    }
+}
+
+void ThreadPool::workerLoop(int queueIndex) {
+    Task task;
+    while (true) {
+        if (popTask(queueIndex, task) || stealTask(queueIndex, task)) {
+            runTask(task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        workAvailable.wait(lock, [this] { return stopping || queuedTasks > 0; });
+        if (stopping) return;
+    }
+}
+
+void ThreadPool::parallelFor(size_t count, size_t grain, const RangeFunction& body) {
+    if (count == 0) return;
+    grain = std::max<size_t>(grain, 1);
+
+    // Chạy thẳng khi chỉ có một khúc, khỏi tốn công qua hàng đợi
+    if (queueCount == 1 || count <= grain) {
+        body(0, count);
+        return;
+    }
+
+    size_t taskCount = (count + grain - 1) / grain;
+    pendingTasks += taskCount;
+
+    // Chia đều các khúc theo vòng cho mọi hàng đợi; luồng nào xong sớm sẽ trộm phần còn lại
+    for (size_t i = 0; i < taskCount; i++) {
+        Task task = {&body, i * grain, std::min(count, (i + 1) * grain)};
+        WorkQueue& queue = queues[i % queueCount];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(task);
+        queuedTasks++;
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        workAvailable.notify_all();
+    }
+
+    Task task;
+    while (popTask(0, task) || stealTask(0, task)) {
+        runTask(task);
+    }
+
+    std::unique_lock<std::mutex> lock(sleepMutex);
+    workFinished.wait(lock, [this] { return pendingTasks == 0; });
+}
@@ -0,0 +1,61 @@
+#ifndef THREADPOOL_H_INCLUDED
+#define THREADPOOL_H_INCLUDED
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Thread pool kiểu work-stealing: mỗi luồng có hàng đợi riêng, lấy việc từ cuối hàng của mình
+// và khi hết việc thì "trộm" từ đầu hàng của luồng khác. Luồng gọi parallelFor cũng làm việc
+// cùng các worker, nên ThreadPool(1) chạy tuần tự mà không tạo luồng nào.
+class ThreadPool {
+public:
+    typedef std::function<void(size_t begin, size_t end)> RangeFunction;
+
+private:
+    struct Task {
+        const RangeFunction* body;
+        size_t begin;
+        size_t end;
+    };
+
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::thread> workers;
+    std::unique_ptr<WorkQueue[]> queues;
+    int queueCount;
+
+    std::mutex sleepMutex;
+    std::condition_variable workAvailable;
+    std::condition_variable workFinished;
+    std::atomic<size_t> queuedTasks;
+    std::atomic<size_t> pendingTasks;
+    bool stopping;
+
+    bool popTask(int queueIndex, Task& task);
+    bool stealTask(int thiefIndex, Task& task);
+    void runTask(const Task& task);
+    void workerLoop(int queueIndex);
+
+public:
+    explicit ThreadPool(int threadCount);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Chia [0, count) thành các khúc dài grain và chờ tới khi mọi khúc chạy xong
+    void parallelFor(size_t count, size_t grain, const RangeFunction& body);
+
+    int getThreadCount() const { return queueCount; }
+};
+
+#endif // THREADPOOL_H_INCLUDED
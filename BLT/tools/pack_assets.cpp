@@ -0,0 +1,87 @@
+// Đóng gói ảnh, âm thanh và font thành một file cho game mmap lúc khởi động.
+//   ./blt_pack --out assets.pak images sound font
+// Chạy trong thư mục BLT: tên tra cứu là đường dẫn tương đối dùng '/', ví dụ "images/menu.png".
+// Tham số có thể là file hoặc thư mục (lấy mọi file bên trong, kể cả thư mục con).
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "archive.h"
+
+namespace fs = std::filesystem;
+
+static bool readFile(const fs::path& path, std::string& contents) {
+    std::ifstream inFile(path, std::ios::binary);
+    if (!inFile.is_open()) return false;
+    contents.assign((std::istreambuf_iterator<char>(inFile)), std::istreambuf_iterator<char>());
+    return !inFile.bad();
+}
+
+int main(int argc, char* argv[]) {
+    std::string outPath = "assets.pak";
+    std::vector<fs::path> inputs;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            outPath = argv[++i];
+        }
+        else if (argv[i][0] != '-') {
+            inputs.push_back(argv[i]);
+        }
+        else {
+            std::cerr << "Usage: " << argv[0] << " [--out FILE] PATH..." << std::endl;
+            return 2;
+        }
+    }
+    if (inputs.empty()) {
+        std::cerr << "Usage: " << argv[0] << " [--out FILE] PATH..." << std::endl;
+        return 2;
+    }
+
+    std::vector<fs::path> files;
+    for (const fs::path& input : inputs) {
+        std::error_code error;
+        if (fs::is_directory(input, error)) {
+            for (const fs::directory_entry& entry : fs::recursive_directory_iterator(input, error)) {
+                if (entry.is_regular_file()) files.push_back(entry.path());
+            }
+        } else if (fs::is_regular_file(input, error)) {
+            files.push_back(input);
+        } else {
+            std::cerr << "No such file or directory: " << input.string() << std::endl;
+            return 1;
+        }
+    }
+    // Thứ tự cố định để cùng bộ tài nguyên luôn cho ra cùng một file
+    std::sort(files.begin(), files.end());
+    files.erase(std::unique(files.begin(), files.end()), files.end());
+
+    std::vector<std::string> names;
+    std::vector<std::string> contents;
+    uint64_t totalBytes = 0;
+    for (const fs::path& file : files) {
+        std::string bytes;
+        if (!readFile(file, bytes)) {
+            std::cerr << "Failed to read " << file.string() << std::endl;
+            return 1;
+        }
+        names.push_back(file.lexically_normal().generic_string());
+        contents.push_back(std::move(bytes));
+        totalBytes += contents.back().size();
+        std::cout << "  " << names.back() << " (" << contents.back().size() << " bytes)" << std::endl;
+    }
+
+    if (!AssetArchive::write(outPath, names, contents)) return 1;
+
+    // Đọc lại để chắc chắn file vừa ghi mở được
+    AssetArchive check;
+    if (!check.open(outPath) || check.getFileCount() != names.size()) {
+        std::cerr << "Written archive " << outPath << " does not read back" << std::endl;
+        return 1;
+    }
+    std::cout << "Packed " << names.size() << " files, " << totalBytes << " bytes into " << outPath << std::endl;
+    return 0;
+}
@@ -0,0 +1,365 @@
+// Kiểm tra offline rằng màn chơi sinh ra từ mỗi seed luôn leo được.
+//   ./blt_validate --seeds 1000000 --height 10000 --lives 4 --threads 0
+// Với mỗi seed, sinh màn chơi của --lives lượt chơi đầu giống World (lượt đầu lúc vào game, các lượt sau
+// khi chơi lại, mỗi lượt một levelSeed riêng) tới độ cao --height, rồi dò từ chỗ xuất phát xem platform
+// nào nhảy tới được. In ra platform đầu tiên không với tới được. Chế độ luyện tập (--start-height) không được kiểm tra.
+// Mã thoát khác 0 nếu có seed bị chặn đường (không còn platform nào phía trên với tới được).
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+#include "chunk.h"
+#include "def.h"
+#include "platform.h"
+#include "threadpool.h"
+#include "world.h"
+
+// Chunk chỉ phụ thuộc (seed, chỉ số) nên camera đi từng bước một chunk cũng cho cùng màn chơi
+static const double CAMERA_STEP = CHUNK_HEIGHT;
+static const uint64_t BATCH_SIZE = 1 << 16;
+
+// Khoảng vị trí x có thể của người chơi; tính theo toạ độ chưa quấn mép màn hình
+struct XSpan {
+    double low;
+    double high;
+    bool valid;
+};
+
+struct SeedResult {
+    uint64_t seed;
+    int life;
+    bool hasUnreachable;
+    bool blocked;
+    LevelPlatform firstUnreachable;
+    size_t firstUnreachableIndex;
+    double highestReachable;
+};
+
+// Quỹ đạo một cú nhảy, tính một lần từ các hằng số vật lý. Độ cao tính từ điểm bật, hướng lên là dương.
+class JumpEnvelope {
+private:
+    std::vector<double> descentHeights;
+    std::vector<int> descentTicks;
+    double apex;
+    float stepX;
+
+public:
+    JumpEnvelope(const WorldTuning& tuning, double maxDrop) {
+        stepX = tuning.stepX;
+        apex = 0.0;
+
+        // Giống Player::update: cộng trọng lực vào vận tốc rồi mới dịch chuyển
+        double velocity = tuning.jumpStrength;
+        double height = 0.0;
+        for (int tick = 1; height > -maxDrop; tick++) {
+            velocity += tuning.gravity;
+            height -= velocity;
+            apex = std::max(apex, height);
+
+            // Chỉ chạm được platform khi đang rơi xuống
+            if (velocity > 0.0) {
+                descentHeights.push_back(height);
+                descentTicks.push_back(tick);
+            }
+        }
+    }
+
+    double getApex() const { return apex; }
+
+    // Số tick bay trước khi chạm platform cao hơn điểm bật rise pixel, -1 nếu không với tới
+    int landingTick(double rise) const {
+        if (rise >= apex) return -1;
+
+        // descentHeights giảm dần; tìm tick đầu tiên mà bàn chân xuống dưới mặt platform
+        auto it = std::upper_bound(descentHeights.begin(), descentHeights.end(), rise,
+                                   [](double value, double height) { return value > height; });
+        if (it == descentHeights.end()) return -1;
+        return descentTicks[it - descentHeights.begin()];
+    }
+
+    double reach(int ticks) const { return stepX * ticks; }
+};
+
+class LevelValidator {
+private:
+    JumpEnvelope envelope;
+    double targetHeight;
+    int screenWidth;
+    int screenHeight;
+    double playerWidth;
+    double platformWidth;
+    double wrapPeriod;
+    double startX;
+    double startY;
+
+    // Các vị trí x của người chơi mà vẫn đứng trên platform. Platform di chuyển quét gần hết
+    // bề ngang màn hình, nên coi như người chơi có thể canh thời điểm để gặp nó ở bất cứ đâu.
+    XSpan landingWindow(const LevelPlatform& platform) const {
+        if ((PlatformType)platform.type == PlatformType::MOVING) {
+            return {-playerWidth, (double)screenWidth, true};
+        }
+        return {platform.x - playerWidth, platform.x + platformWidth, true};
+    }
+
+    // Phần của target mà người chơi tới được khi xuất phát trong from và có thể đi ngang distance pixel
+    XSpan spanReach(const XSpan& from, double distance, const XSpan& target) const {
+        XSpan result = {0.0, 0.0, false};
+        double low = from.low - distance;
+        double high = from.high + distance;
+        if (high - low >= wrapPeriod) return target;
+
+        double shift = std::round(((target.low + target.high) - (low + high)) * 0.5 / wrapPeriod) * wrapPeriod;
+        for (int k = -1; k <= 1; k++) {
+            double shiftedLow = std::max(low + shift + k * wrapPeriod, target.low);
+            double shiftedHigh = std::min(high + shift + k * wrapPeriod, target.high);
+            if (shiftedLow >= shiftedHigh) continue;
+
+            if (!result.valid) {
+                result = {shiftedLow, shiftedHigh, true};
+            } else {
+                result.low = std::min(result.low, shiftedLow);
+                result.high = std::max(result.high, shiftedHigh);
+            }
+        }
+        return result;
+    }
+
+    static void mergeSpan(XSpan& into, const XSpan& span) {
+        if (!span.valid) return;
+        if (!into.valid) {
+            into = span;
+            return;
+        }
+        into.low = std::min(into.low, span.low);
+        into.high = std::max(into.high, span.high);
+    }
+
+public:
+    LevelValidator(const World& reference, double targetHeight)
+        : envelope(reference.getTuning(), reference.getTuning().screenHeight * 2.0) {
+        WorldTuning tuning = reference.getTuning();
+        this->targetHeight = targetHeight;
+        screenWidth = tuning.screenWidth;
+        screenHeight = tuning.screenHeight;
+        playerWidth = reference.getPlayer().getWidth();
+        platformWidth = reference.getPlatformManager().getPlatformWidth();
+        wrapPeriod = screenWidth + playerWidth;
+        startX = reference.getPlayer().getX();
+        startY = reference.getPlayer().getY();
+    }
+
+    const JumpEnvelope& getEnvelope() const { return envelope; }
+
+    // Sinh màn chơi của lượt vừa initialize() giống World: camera từ 0 đi lên, nạp dần các chunk
+    void generateLevel(PlatformManager& platformManager, std::vector<LevelPlatform>& level) const {
+        level.clear();
+
+        double recordedTop = INFINITY;
+        std::vector<LevelPlatform> added;
+        double cameraY = 0.0;
+
+        while (true) {
+            added.clear();
+            for (int t = 0; t < PLATFORM_TYPE_COUNT; t++) {
+                PlatformType type = (PlatformType)t;
+                const PlatformLane& lane = platformManager.getLane(type);
+                for (size_t i = lane.size(); i > 0 && lane.getY(i - 1) < recordedTop; i--) {
+                    double y = lane.getY(i - 1);
+                    added.push_back({lane.getX(i - 1), y, (uint8_t)type, chunkDifficulty(chunkIndexAt(y))});
+                }
+            }
+            std::sort(added.begin(), added.end(),
+                      [](const LevelPlatform& a, const LevelPlatform& b) { return a.y > b.y; });
+            level.insert(level.end(), added.begin(), added.end());
+            if (!level.empty()) recordedTop = level.back().y;
+
+            if (cameraY <= -targetHeight) break;
+
+            cameraY -= CAMERA_STEP;
+            platformManager.removeBottomPlatforms(cameraY);
+            platformManager.streamChunks(cameraY);
+        }
+    }
+
+    // Chỉ xét đường leo lên (không tính rơi xuống platform thấp hơn, trừ cú nhảy đầu tiên),
+    // nên kết quả "leo được" là chắc chắn, còn "không với tới" có thể hơi khắt khe.
+    void validateLevel(const std::vector<LevelPlatform>& level, std::vector<XSpan>& spans, SeedResult& result) const {
+        spans.assign(level.size(), {0.0, 0.0, false});
+
+        result.hasUnreachable = false;
+        result.blocked = false;
+        result.firstUnreachableIndex = 0;
+        result.highestReachable = -startY;
+
+        XSpan start = {startX, startX, true};
+        double apex = envelope.getApex();
+        size_t highestReachableIndex = 0;
+        bool anyReachable = false;
+
+        for (size_t j = 0; j < level.size(); j++) {
+            const LevelPlatform& target = level[j];
+            XSpan window = landingWindow(target);
+            XSpan arrival = {0.0, 0.0, false};
+
+            // Cú nhảy đầu tiên bắt đầu giữa không trung và có thể rơi xuống bất kỳ platform nào trên màn hình
+            if (target.y < screenHeight) {
+                int ticks = envelope.landingTick(startY - target.y);
+                if (ticks >= 0) mergeSpan(arrival, spanReach(start, envelope.reach(ticks), window));
+            }
+
+            for (size_t i = j; i > 0; i--) {
+                const LevelPlatform& source = level[i - 1];
+                double rise = source.y - target.y;
+                if (rise >= apex) break;
+                if (!spans[i - 1].valid) continue;
+
+                int ticks = envelope.landingTick(rise);
+                if (ticks >= 0) mergeSpan(arrival, spanReach(spans[i - 1], envelope.reach(ticks), window));
+            }
+
+            if (!arrival.valid) {
+                if (!result.hasUnreachable) {
+                    result.hasUnreachable = true;
+                    result.firstUnreachable = target;
+                    result.firstUnreachableIndex = j;
+                }
+                continue;
+            }
+
+            // Platform thường và di chuyển có thể nảy lại nhiều lần để chỉnh vị trí;
+            // platform vỡ chỉ bật được một lần từ chỗ vừa đáp xuống
+            spans[j] = (PlatformType)target.type == PlatformType::BREAKABLE ? arrival : window;
+            highestReachableIndex = j;
+            anyReachable = true;
+        }
+
+        if (anyReachable) result.highestReachable = -level[highestReachableIndex].y;
+        result.blocked = result.hasUnreachable
+            && (!anyReachable || highestReachableIndex < result.firstUnreachableIndex
+                || result.highestReachable < targetHeight - screenHeight);
+    }
+
+    // Các lượt dùng chung một PlatformManager như trong World, vì lượt sau phụ thuộc số ngẫu nhiên
+    // lượt trước đã dùng. Giữ lại lượt tệ nhất: bị chặn đường trước, rồi tới có platform không với tới.
+    void validate(uint64_t seed, int lives, std::vector<LevelPlatform>& level, std::vector<XSpan>& spans,
+                  SeedResult& result) const {
+        PlatformManager platformManager(screenWidth, screenHeight, seed);
+        result = {};
+        result.seed = seed;
+
+        for (int life = 0; life < lives; life++) {
+            platformManager.initialize(life == 0 ? WORLD_FIRST_SCREEN_PLATFORMS : WORLD_RETRY_SCREEN_PLATFORMS);
+            generateLevel(platformManager, level);
+
+            SeedResult lifeResult = {};
+            validateLevel(level, spans, lifeResult);
+            if (life == 0 || (lifeResult.hasUnreachable && (!result.hasUnreachable || (lifeResult.blocked && !result.blocked)))) {
+                result = lifeResult;
+                result.seed = seed;
+                result.life = life;
+            }
+            if (result.blocked) break;
+        }
+    }
+};
+
+static const char* platformTypeName(PlatformType type) {
+    switch (type) {
+    case PlatformType::MOVING:
+        return "moving";
+    case PlatformType::BREAKABLE:
+        return "breakable";
+    default:
+        return "normal";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    uint64_t firstSeed = 0;
+    uint64_t seedCount = 100000;
+    double targetHeight = 10000.0;
+    int threadCount = 0;
+    int lives = 4;
+    uint64_t maxReports = 20;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--first") == 0 && i + 1 < argc) {
+            firstSeed = std::strtoull(argv[++i], NULL, 10);
+        }
+        else if (std::strcmp(argv[i], "--seeds") == 0 && i + 1 < argc) {
+            seedCount = std::strtoull(argv[++i], NULL, 10);
+        }
+        else if (std::strcmp(argv[i], "--height") == 0 && i + 1 < argc) {
+            targetHeight = std::atof(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--lives") == 0 && i + 1 < argc) {
+            lives = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threadCount = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--reports") == 0 && i + 1 < argc) {
+            maxReports = std::strtoull(argv[++i], NULL, 10);
+        }
+        else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--first SEED] [--seeds N] [--height PIXELS] [--lives N] [--threads N] [--reports N]" << std::endl;
+            return 2;
+        }
+    }
+
+    World reference(SCREEN_WIDTH, SCREEN_HEIGHT, 0);
+    LevelValidator validator(reference, targetHeight);
+    ThreadPool pool(threadCount);
+
+    WorldTuning tuning = reference.getTuning();
+    std::cout << "Jump apex " << validator.getEnvelope().getApex() << " px (jump " << tuning.jumpStrength
+              << ", gravity " << tuning.gravity << ", step " << tuning.stepX << "), checking "
+              << seedCount << " seeds (" << lives << " lives each) up to height " << targetHeight << " on "
+              << pool.getThreadCount() << " threads" << std::endl;
+
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+    std::vector<SeedResult> results;
+    uint64_t unreachableSeeds = 0;
+    uint64_t blockedSeeds = 0;
+    uint64_t reports = 0;
+
+    for (uint64_t batchStart = 0; batchStart < seedCount; batchStart += BATCH_SIZE) {
+        size_t batchSize = (size_t)std::min<uint64_t>(BATCH_SIZE, seedCount - batchStart);
+        results.resize(batchSize);
+
+        pool.parallelFor(batchSize, 64, [&](size_t begin, size_t end) {
+            std::vector<LevelPlatform> level;
+            std::vector<XSpan> spans;
+            for (size_t i = begin; i < end; i++) {
+                validator.validate(firstSeed + batchStart + i, lives, level, spans, results[i]);
+            }
+        });
+
+        for (size_t i = 0; i < batchSize; i++) {
+            const SeedResult& result = results[i];
+            if (!result.hasUnreachable) continue;
+
+            unreachableSeeds++;
+            if (result.blocked) blockedSeeds++;
+            if (reports++ >= maxReports) continue;
+
+            const LevelPlatform& platform = result.firstUnreachable;
+            std::cout << "seed " << result.seed << " life " << result.life << ": platform #" << result.firstUnreachableIndex
+                      << " (" << platformTypeName((PlatformType)platform.type) << ", x " << platform.x
+                      << ", height " << -platform.y << ", difficulty " << platform.difficulty
+                      << ") unreachable, highest reachable " << result.highestReachable
+                      << (result.blocked ? " [blocked]" : "") << std::endl;
+        }
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    std::cout << seedCount << " seeds in " << seconds << " s (" << (seconds > 0.0 ? seedCount / seconds : 0.0)
+              << " seeds/s): " << unreachableSeeds << " with an unreachable platform in the first " << lives << " lives, "
+              << blockedSeeds << " blocked" << std::endl;
+
+    return blockedSeeds > 0 ? 1 : 0;
+}
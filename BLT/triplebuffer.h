@@ -0,0 +1,52 @@
+#ifndef TRIPLEBUFFER_H_INCLUDED
+#define TRIPLEBUFFER_H_INCLUDED
+#include <atomic>
+#include <cstdint>
+
+// Bộ đệm ba ô để một luồng ghi và một luồng đọc trao đổi trạng thái mà không khoá.
+// Luồng ghi luôn có ô riêng để viết, luồng đọc luôn có ô riêng để đọc; ô giữa được đổi
+// chỗ bằng một phép exchange. Không bên nào phải chờ bên kia, bên đọc chỉ bỏ lỡ các
+// bản cũ khi bên ghi nhanh hơn.
+template <typename T>
+class TripleBuffer {
+private:
+    static constexpr uint8_t INDEX_MASK = 3;
+    static constexpr uint8_t FRESH_BIT = 4;
+
+    T slots[3];
+    // Chỉ số ô giữa, kèm FRESH_BIT khi bên ghi vừa đưa vào một bản mà bên đọc chưa lấy
+    std::atomic<uint8_t> middle;
+    uint8_t writeIndex;
+    uint8_t readIndex;
+
+public:
+    TripleBuffer() {
+        middle.store(1);
+        writeIndex = 0;
+        readIndex = 2;
+    }
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // Chỉ luồng ghi gọi. Ô này chứa dữ liệu cũ nên phải ghi lại toàn bộ trước khi publish.
+    T& writeSlot() { return slots[writeIndex]; }
+
+    void publish() {
+        uint8_t previous = middle.exchange(writeIndex | FRESH_BIT, std::memory_order_acq_rel);
+        writeIndex = previous & INDEX_MASK;
+    }
+
+    // Chỉ luồng đọc gọi; trả về true nếu đã lấy được bản mới hơn
+    bool acquire() {
+        if (!(middle.load(std::memory_order_relaxed) & FRESH_BIT)) return false;
+
+        uint8_t previous = middle.exchange(readIndex, std::memory_order_acq_rel);
+        readIndex = previous & INDEX_MASK;
+        return true;
+    }
+
+    const T& readSlot() const { return slots[readIndex]; }
+};
+
+#endif // TRIPLEBUFFER_H_INCLUDED
@@ -0,0 +1,159 @@
+#include "world.h"
+#include "def.h"
+#include <cmath>
+#include <type_traits>
+
+static_assert(std::is_trivially_copyable<WorldSnapshot>::value, "WorldSnapshot must stay a flat blob");
+
+World::World(int screenWidth, int screenHeight, uint64_t seed)
+    : player(screenWidth / 2, screenHeight / 2, 80),
+      platformManager(screenWidth, screenHeight, seed) {
+    this->screenWidth = screenWidth;
+    this->screenHeight = screenHeight;
+    this->seed = seed;
+    score = 0;
+    cameraY = 0.0;
+    prevCameraY = 0.0;
+    cameraThreshold = 300;
+    startHeight = 0.0;
+    gameOver = false;
+    events = WORLD_EVENT_NONE;
+    profiler = nullptr;
+
+    platformManager.initialize(WORLD_FIRST_SCREEN_PLATFORMS);
+}
+
+World::~World() {}
+
+void World::tick(const InputState& input) {
+    events = WORLD_EVENT_NONE;
+    if (gameOver) return;
+
+    player.savePreviousState();
+    platformManager.savePreviousState();
+    prevCameraY = cameraY;
+
+    if (!player.getIsJumping()) {
+        player.jump();
+        events |= WORLD_EVENT_JUMP;
+    }
+
+    if (input.right) {
+        player.moveRight(input.rightHold / (float)INPUT_HOLD_STEPS);
+    }
+
+    if (input.left) {
+        player.moveLeft(input.leftHold / (float)INPUT_HOLD_STEPS);
+    }
+
+    {
+        ProfileScope scope(profiler, PHASE_UPDATE_PLAYER);
+        player.update(platformManager);
+    }
+    {
+        ProfileScope scope(profiler, PHASE_UPDATE_PLATFORMS);
+        platformManager.update();
+    }
+    {
+        ProfileScope scope(profiler, PHASE_UPDATE_DIFFICULTY);
+        platformManager.updateDifficulty(-cameraY);
+    }
+
+    // Camera chỉ đi lên; điểm chính là độ cao camera đã đạt được
+    if (player.getY() - cameraY < cameraThreshold) {
+        ProfileScope scope(profiler, PHASE_UPDATE_CAMERA);
+        cameraY = player.getY() - cameraThreshold;
+        score = (int)-cameraY;
+        platformManager.removeBottomPlatforms(cameraY);
+        platformManager.streamChunks(cameraY);
+    }
+
+    if (player.getY() - cameraY > screenHeight) {
+        gameOver = true;
+        events |= WORLD_EVENT_FALL;
+    }
+}
+
+void World::restart() {
+    gameOver = false;
+    cameraY = -startHeight;
+    prevCameraY = cameraY;
+    score = (int)startHeight;
+
+    if (startHeight <= 0.0) {
+        player.setPosition(screenWidth / 2, screenHeight / 2);
+        platformManager.initialize(WORLD_RETRY_SCREEN_PLATFORMS);
+    } else {
+        platformManager.initializeAt(cameraY);
+        placePlayerNearCenter();
+    }
+}
+
+// Đặt người chơi lên platform thường gần giữa màn hình nhất, để lượt luyện tập không rơi ngay
+void World::placePlayerNearCenter() {
+    double targetY = cameraY + screenHeight * 0.6;
+    float bestX = screenWidth / 2.0f;
+    double bestY = targetY;
+    double bestDistance = INFINITY;
+
+    for (int t = 0; t < PLATFORM_TYPE_COUNT; t++) {
+        const PlatformLane& lane = platformManager.getLane((PlatformType)t);
+        bool isNormal = (PlatformType)t == PlatformType::NORMAL;
+
+        for (size_t i = 0; i < lane.size(); i++) {
+            double y = lane.getY(i);
+            if (y < cameraY || y > cameraY + screenHeight) continue;
+
+            // Ưu tiên platform thường; loại khác chỉ dùng khi không còn lựa chọn
+            double distance = std::fabs(y - targetY) + (isNormal ? 0.0 : screenHeight);
+            if (distance < bestDistance) {
+                bestDistance = distance;
+                bestX = lane.getX(i) + (platformManager.getPlatformWidth() - player.getWidth()) / 2.0f;
+                bestY = y;
+            }
+        }
+    }
+
+    player.setPosition(bestX, bestY);
+    player.setVelocityY(0.0f);
+}
+
+WorldTuning World::getTuning() const {
+    WorldTuning tuning;
+    tuning.tickRate = TICK_RATE;
+    tuning.screenWidth = screenWidth;
+    tuning.screenHeight = screenHeight;
+    tuning.cameraThreshold = cameraThreshold;
+    tuning.breakTicks = platformManager.getBreakTicks();
+    tuning.stepX = player.getStepX();
+    tuning.gravity = player.getGravity();
+    tuning.jumpStrength = player.getJumpStrength();
+    tuning.movingSpeed = platformManager.getMovingSpeed();
+    return tuning;
+}
+
+bool World::snapshot(WorldSnapshot& out) const {
+    out.seed = seed;
+    player.saveState(out.player);
+    if (!platformManager.saveState(out.platforms)) return false;
+    out.score = score;
+    out.cameraY = cameraY;
+    out.prevCameraY = prevCameraY;
+    out.startHeight = startHeight;
+    out.gameOver = gameOver;
+    out.events = events;
+    return true;
+}
+
+bool World::restore(const WorldSnapshot& in) {
+    if (!platformManager.restoreState(in.platforms)) return false;
+    seed = in.seed;
+    player.restoreState(in.player);
+    score = in.score;
+    cameraY = in.cameraY;
+    prevCameraY = in.prevCameraY;
+    startHeight = in.startHeight;
+    gameOver = in.gameOver != 0;
+    events = in.events;
+    return true;
+}
@@ -0,0 +1,102 @@
+#ifndef WORLD_H_INCLUDED
+#define WORLD_H_INCLUDED
+#include <cstdint>
+#include "player.h"
+#include "platform.h"
+#include "profiler.h"
+
+// Một tick chia thành INPUT_HOLD_STEPS nấc; leftHold/rightHold là số nấc mà phím được giữ.
+// Mặc định là giữ cả tick, đúng với input chỉ có bật/tắt như bot hay replay cũ.
+const int INPUT_HOLD_STEPS = 8;
+
+// Số platform của màn đầu khi vào game và khi chơi lại (chơi lại dày hơn); blt_validate dựng màn giống vậy
+const int WORLD_FIRST_SCREEN_PLATFORMS = 10;
+const int WORLD_RETRY_SCREEN_PLATFORMS = 15;
+
+struct InputState {
+    bool left = false;
+    bool right = false;
+    uint8_t leftHold = INPUT_HOLD_STEPS;
+    uint8_t rightHold = INPUT_HOLD_STEPS;
+};
+
+// Các hằng số ảnh hưởng tới mô phỏng; replay lưu lại để phát hiện khi bản build đã đổi luật
+struct WorldTuning {
+    int32_t tickRate;
+    int32_t screenWidth;
+    int32_t screenHeight;
+    int32_t cameraThreshold;
+    int32_t breakTicks;
+    float stepX;
+    float gravity;
+    float jumpStrength;
+    float movingSpeed;
+};
+
+enum WorldEvent : unsigned {
+    WORLD_EVENT_NONE = 0,
+    WORLD_EVENT_JUMP = 1 << 0,
+    WORLD_EVENT_FALL = 1 << 1
+};
+
+// Toàn bộ trạng thái mô phỏng trong một khối phẳng (vài KB), sao chép được bằng một memcpy.
+// Dùng cho tua lại, bot tìm kiếm, và chia đôi replay để tìm chỗ lệch.
+struct WorldSnapshot {
+    uint64_t seed;
+    PlayerState player;
+    PlatformManagerSnapshot platforms;
+    int32_t score;
+    double cameraY;
+    double prevCameraY;
+    double startHeight;
+    uint8_t gameOver;
+    uint32_t events;
+};
+
+// Toàn bộ luật chơi, không phụ thuộc SDL. Game chỉ đọc trạng thái để vẽ và phát âm thanh.
+class World {
+private:
+    int screenWidth;
+    int screenHeight;
+    uint64_t seed;
+    Player player;
+    PlatformManager platformManager;
+    int score;
+    double cameraY;
+    double prevCameraY;
+    int cameraThreshold;
+    double startHeight;
+    bool gameOver;
+    unsigned events;
+    Profiler* profiler;
+
+    void placePlayerNearCenter();
+
+public:
+    World(int screenWidth, int screenHeight, uint64_t seed);
+    ~World();
+
+    void tick(const InputState& input);
+    void restart();
+    // Độ cao bắt đầu của các lượt chơi sau (chế độ luyện tập); 0 là chơi từ mặt đất
+    void setStartHeight(double height) { startHeight = height > 0.0 ? height : 0.0; }
+    double getStartHeight() const { return startHeight; }
+    void setProfiler(Profiler* newProfiler) { profiler = newProfiler; }
+    void setChunkStreamer(ChunkStreamer* streamer) { platformManager.setChunkStreamer(streamer); }
+
+    const Player& getPlayer() const { return player; }
+    const PlatformManager& getPlatformManager() const { return platformManager; }
+    uint64_t getSeed() const { return seed; }
+    int getScore() const { return score; }
+    double getCameraY() const { return cameraY; }
+    double getPrevCameraY() const { return prevCameraY; }
+    int getDifficultyLevel() const { return platformManager.getDifficultyLevel(); }
+    bool isGameOver() const { return gameOver; }
+    unsigned getEvents() const { return events; }
+    WorldTuning getTuning() const;
+
+    bool snapshot(WorldSnapshot& out) const;
+    bool restore(const WorldSnapshot& in);
+};
+
+#endif // WORLD_H_INCLUDED